@@ -3,6 +3,7 @@
 #include "EdGraph/EdGraphSchema.h"
 #include "CreatureAnimStateNode.h"
 #include "CreatureAnimGraphSchema.h"
+#include "CreatureAnimStateMachine.h"
 
 UCreatureStateMachineGraph::UCreatureStateMachineGraph(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -48,6 +49,11 @@ void UCreatureStateMachineGraph::CompileNodes()
 		Node->Compile();
 	}
 
+	if (ParentStateMachine)
+	{
+		ParentStateMachine->CompileTransitionTable();
+	}
+
 	m_isDirty = false;
 }
 
@@ -248,6 +248,18 @@ ACreatureActor::GetBluePrintBoneXform_Name(FName name_in, bool world_transform,
 	return creature_core.GetBluePrintBoneXform(name_in, world_transform, position_slide_factor, GetTransform());
 }
 
+int32
+ACreatureActor::GetBluePrintBoneIndex(FName name_in) const
+{
+	return creature_core.GetBoneDataIndex(name_in);
+}
+
+FTransform
+ACreatureActor::GetBluePrintBoneXform_Index(int32 bone_index, bool world_transform, float position_slide_factor)
+{
+	return creature_core.GetBoneXform(bone_index, world_transform, position_slide_factor, GetTransform());
+}
+
 bool
 ACreatureActor::IsBluePrintBonesCollide(FVector test_point, float bone_size)
 {
@@ -305,6 +317,11 @@ void ACreatureActor::Tick(float DeltaTime)
 		creature_mesh->SetBoundsOffset(creature_bounds_offset);
 
 		creature_mesh->SetTagString(GetName());
+		if (creature_core.should_update_render_attributes)
+		{
+			creature_mesh->MarkAttributesDirty();
+		}
+
 		creature_mesh->ForceAnUpdate();
 	}
 }
@@ -315,9 +332,10 @@ ACreatureActor::GetBluePrintAnimationFrame()
 	return creature_core.GetBluePrintAnimationFrame();
 }
 
-void ACreatureActor::SetBluePrintRegionCustomOrder(TArray<FString> order_in)
+void ACreatureActor::SetBluePrintRegionCustomOrder(const TArray<FString>& order_in)
 {
 	TArray<FName> order_name;
+	order_name.Reserve(order_in.Num());
 	for (const FString &str : order_in)
 	{
 		order_name.Add(FName(*str));
@@ -325,7 +343,7 @@ void ACreatureActor::SetBluePrintRegionCustomOrder(TArray<FString> order_in)
 	creature_core.SetBluePrintRegionCustomOrder(order_name);
 }
 
-void ACreatureActor::SetBluePrintRegionCustomOrder_Name(TArray<FName> order_in)
+void ACreatureActor::SetBluePrintRegionCustomOrder_Name(const TArray<FName>& order_in)
 {
 	creature_core.SetBluePrintRegionCustomOrder(order_in);
 }
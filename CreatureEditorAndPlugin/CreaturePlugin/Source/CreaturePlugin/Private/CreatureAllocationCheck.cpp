@@ -0,0 +1,187 @@
+#include "CreaturePluginPCH.h"
+#include "CreatureAllocationCheck.h"
+
+#if !UE_BUILD_SHIPPING
+
+// Forwards everything to the allocator it wraps, and counts the allocations of threads inside a check scope
+class FCreatureCountingMalloc : public FMalloc
+{
+public:
+	FCreatureCountingMalloc(FMalloc * inner_in)
+		: inner(inner_in)
+	{
+		tls_slot = FPlatformTLS::AllocTlsSlot();
+	}
+
+	// Counter of the innermost check scope of this thread, null outside of one
+	int32 * GetCounter() const
+	{
+		return (int32 *)FPlatformTLS::GetTlsValue(tls_slot);
+	}
+
+	void SetCounter(int32 * counter_in)
+	{
+		FPlatformTLS::SetTlsValue(tls_slot, counter_in);
+	}
+
+	virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+	{
+		CountAllocation();
+		return inner->Malloc(Count, Alignment);
+	}
+
+	virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+	{
+		// Shrinking to nothing is a free, everything else may have to move the block
+		if (Count > 0)
+		{
+			CountAllocation();
+		}
+
+		return inner->Realloc(Original, Count, Alignment);
+	}
+
+	virtual void Free(void* Original) override
+	{
+		inner->Free(Original);
+	}
+
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+	{
+		return inner->QuantizeSize(Count, Alignment);
+	}
+
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+	{
+		return inner->GetAllocationSize(Original, SizeOut);
+	}
+
+	virtual void Trim() override
+	{
+		inner->Trim();
+	}
+
+	virtual void SetupTLSCachesOnCurrentThread() override
+	{
+		inner->SetupTLSCachesOnCurrentThread();
+	}
+
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+	{
+		inner->ClearAndDisableTLSCachesOnCurrentThread();
+	}
+
+	virtual void InitializeStatsMetadata() override
+	{
+		inner->InitializeStatsMetadata();
+	}
+
+	virtual void UpdateStats() override
+	{
+		inner->UpdateStats();
+	}
+
+	virtual void GetAllocatorStats(FGenericMemoryStats& out_Stats) override
+	{
+		inner->GetAllocatorStats(out_Stats);
+	}
+
+	virtual void DumpAllocatorStats(class FOutputDevice& Ar) override
+	{
+		inner->DumpAllocatorStats(Ar);
+	}
+
+	virtual bool IsInternallyThreadSafe() const override
+	{
+		return inner->IsInternallyThreadSafe();
+	}
+
+	virtual bool ValidateHeap() override
+	{
+		return inner->ValidateHeap();
+	}
+
+	virtual const TCHAR* GetDescriptiveName() override
+	{
+		return inner->GetDescriptiveName();
+	}
+
+protected:
+	void CountAllocation()
+	{
+		int32 * cur_counter = GetCounter();
+		if (cur_counter)
+		{
+			(*cur_counter)++;
+		}
+	}
+
+	FMalloc * inner;
+	uint32 tls_slot;
+};
+
+// Installed the first time the check is turned on and never removed, blocks made before it go back to the allocator it wraps
+static FCreatureCountingMalloc * counting_malloc = nullptr;
+
+static int32 creature_check_tick_allocations = 0;
+
+static void OnCheckTickAllocationsChanged(IConsoleVariable * var_in)
+{
+	if ((creature_check_tick_allocations != 0) && !counting_malloc && GMalloc)
+	{
+		counting_malloc = new FCreatureCountingMalloc(GMalloc);
+		GMalloc = counting_malloc;
+	}
+}
+
+static FAutoConsoleVariableRef CVarCreatureCheckTickAllocations(
+	TEXT("creature.CheckTickAllocations"),
+	creature_check_tick_allocations,
+	TEXT("Test mode, counts the heap allocations of every steady state creature update.\n")
+	TEXT("0: off\n")
+	TEXT("1: an update that allocates logs a warning and fails an ensure"),
+	FConsoleVariableDelegate::CreateStatic(&OnCheckTickAllocationsChanged),
+	ECVF_Cheat);
+
+FCreatureScopedAllocationCheck::FCreatureScopedAllocationCheck(const TCHAR * label_in, bool should_report)
+	: label(label_in)
+	, is_reported(should_report)
+	, num_allocations(0)
+	, outer_counter(nullptr)
+{
+	if (counting_malloc)
+	{
+		outer_counter = counting_malloc->GetCounter();
+		counting_malloc->SetCounter(&num_allocations);
+	}
+}
+
+FCreatureScopedAllocationCheck::~FCreatureScopedAllocationCheck()
+{
+	if (!counting_malloc)
+	{
+		return;
+	}
+
+	counting_malloc->SetCounter(outer_counter);
+
+	// The allocations of a nested scope are allocations of this one too
+	if (outer_counter)
+	{
+		*outer_counter += num_allocations;
+	}
+
+	if (is_reported && IsEnabled() && (num_allocations > 0))
+	{
+		// Logging allocates, so it happens after the counter of this scope is taken off the thread
+		UE_LOG(LogTemp, Warning, TEXT("%s - %d heap allocations in a steady state creature update"), label, num_allocations);
+		ensureMsgf(false, TEXT("%s allocated in a steady state creature update, see creature.CheckTickAllocations"), label);
+	}
+}
+
+bool FCreatureScopedAllocationCheck::IsEnabled()
+{
+	return creature_check_tick_allocations != 0;
+}
+
+#endif
@@ -5,5 +5,88 @@
 #include "EdGraph/EdGraphSchema.h"
 UCreatureAnimStateMachine::UCreatureAnimStateMachine(){
 	//StateMachineGraph = NewObject<UCreatureStateMachineGraph>(UCreatureStateMachineGraph::StaticClass());
+	CompiledEntryState = INDEX_NONE;
+	CompiledSerial = 0;
+}
+
+void UCreatureAnimStateMachine::PostLoad()
+{
+	Super::PostLoad();
+
+	CompileTransitionTable();
+}
+
+void UCreatureAnimStateMachine::CompileTransitionTable()
+{
+	CompiledStates.Reset();
+	CompiledTransitions.Reset();
+	CompiledConditions.Reset();
+	ConditionIds.Reset();
+	CompiledEntryState = INDEX_NONE;
+	CompiledSerial++;
+
+	if (RootState == nullptr)
+	{
+		return;
+	}
+
+	// Dense state ids, in breadth first order from the root
+	TMap<UCreatureAnimState*, int32> stateIds;
+	TArray<UCreatureAnimState*> orderedStates;
+	stateIds.Add(RootState, 0);
+	orderedStates.Add(RootState);
+	for (int32 i = 0; i < orderedStates.Num(); i++)
+	{
+		for (UCreatureAnimTransition* tran : orderedStates[i]->TransitionList)
+		{
+			if (tran && tran->TargetState && !stateIds.Contains(tran->TargetState))
+			{
+				stateIds.Add(tran->TargetState, orderedStates.Num());
+				orderedStates.Add(tran->TargetState);
+			}
+		}
+	}
+
+	static const FName animationEndName(TEXT("AnimationEnd"));
+	for (UCreatureAnimState* state : orderedStates)
+	{
+		FCreatureCompiledState compiledState;
+		compiledState.SourceState = state;
+		compiledState.FirstTransition = CompiledTransitions.Num();
+
+		for (UCreatureAnimTransition* tran : state->TransitionList)
+		{
+			if ((tran == nullptr) || (tran->TargetState == nullptr))
+			{
+				continue;
+			}
+
+			FCreatureCompiledTransition compiledTran;
+			compiledTran.FirstCondition = CompiledConditions.Num();
+			compiledTran.NumConditions = tran->TransitionConditions.Num();
+			compiledTran.TargetState = stateIds[tran->TargetState];
+			compiledTran.OnAnimationEnd = (tran->TransitionConditions.Num() > 0)
+				&& (tran->TransitionConditions[0].TransitionName == animationEndName);
+
+			for (const FCreatureTransitionCondition& condition : tran->TransitionConditions)
+			{
+				int32* foundId = ConditionIds.Find(condition.TransitionName);
+				FCreatureCompiledCondition compiledCondition;
+				compiledCondition.ConditionId = foundId ? *foundId : ConditionIds.Add(condition.TransitionName, ConditionIds.Num());
+				compiledCondition.Flag = condition.TransitionFlag;
+				CompiledConditions.Add(compiledCondition);
+			}
+
+			CompiledTransitions.Add(compiledTran);
+		}
+
+		compiledState.NumTransitions = CompiledTransitions.Num() - compiledState.FirstTransition;
+		CompiledStates.Add(compiledState);
+	}
 
+	// Instances start in the first state the root leads to
+	if ((RootState->TransitionList.Num() > 0) && RootState->TransitionList[0] && RootState->TransitionList[0]->TargetState)
+	{
+		CompiledEntryState = stateIds[RootState->TransitionList[0]->TargetState];
+	}
 }
@@ -7,7 +7,9 @@
 
 UCreatureAnimStateMachineInstance::UCreatureAnimStateMachineInstance()
 {
-
+	m_currentStateId = INDEX_NONE;
+	m_compiledSerial = 0;
+	m_needsEvaluation = false;
 }
 
 void UCreatureAnimStateMachineInstance::SetCondition(FString ConditionName, bool Flag)
@@ -24,39 +26,260 @@ bool UCreatureAnimStateMachineInstance::GetCondition(FString ConditionName) cons
 
 bool UCreatureAnimStateMachineInstance::GetConditionByName(FName conditionName) const
 {
-	const bool *value = m_currentConditionValues.Find(conditionName);
+	if (TargetStateMachine == nullptr)
+	{
+		return false;
+	}
+
+	// The bits are still laid out for the previous compile until the next sync
+	int32 conditionId = INDEX_NONE;
+	if (m_compiledSerial == TargetStateMachine->CompiledSerial)
+	{
+		const int32 *foundId = TargetStateMachine->ConditionIds.Find(conditionName);
+		conditionId = foundId ? *foundId : INDEX_NONE;
+	}
+	else {
+		conditionId = m_conditionNames.Find(conditionName);
+	}
 
-	return (value) ? *value : false;
+	if (m_conditionBits.IsValidIndex(conditionId))
+	{
+		return m_conditionBits[conditionId];
+	}
+
+	const bool *unusedFlag = m_unusedConditions.Find(conditionName);
+	return unusedFlag ? *unusedFlag : false;
 }
 
 void UCreatureAnimStateMachineInstance::SetConditionByName(FName conditionName, bool Flag)
 {
-	if (GetConditionByName(conditionName) == Flag)
+	if (TargetStateMachine == nullptr)
 	{
-		// it's already set: skip
 		return;
 	}
 
-	m_currentConditionValues.Add(conditionName, Flag);
+	SyncCompiledTable();
 
-	if (CurrentState)
+	const int32 *conditionId = TargetStateMachine->ConditionIds.Find(conditionName);
+	if (conditionId == nullptr)
 	{
-		CurrentState->CheckCondition(this);
+		// not used by any transition, nothing to evaluate
+		m_unusedConditions.Add(conditionName, Flag);
+		return;
+	}
+
+	if (m_conditionBits[*conditionId] == Flag)
+	{
+		// already set: skip
+		return;
 	}
+
+	m_conditionBits[*conditionId] = Flag;
+	m_needsEvaluation = true;
+
+	EvaluatePendingTransitions();
 }
 
 void UCreatureAnimStateMachineInstance::SetCurrentState(UCreatureAnimState *state)
 {
-	if (CurrentState)
+	if (TargetStateMachine == nullptr)
 	{
-		CurrentState->EndState(this);
+		return;
 	}
 
-	CurrentState = state;
+	SyncCompiledTable();
+
+	SetCurrentStateId(TargetStateMachine->CompiledStates.IndexOfByPredicate([state](const FCreatureCompiledState& compiledState) {
+		return compiledState.SourceState == state;
+	}));
+}
 
-	if (CurrentState)
+UCreatureAnimState * UCreatureAnimStateMachineInstance::GetCurrentState() const
+{
+	if ((TargetStateMachine == nullptr) || !TargetStateMachine->CompiledStates.IsValidIndex(m_currentStateId))
 	{
-		CurrentState->BeginState(this);
+		return nullptr;
+	}
+
+	return TargetStateMachine->CompiledStates[m_currentStateId].SourceState;
+}
+
+void UCreatureAnimStateMachineInstance::SetCurrentStateId(int32 stateId)
+{
+	if (UCreatureAnimState *oldState = GetCurrentState())
+	{
+		oldState->EndState(this);
+	}
+
+	// A state leading back into itself gives the same result until a condition changes
+	m_needsEvaluation = m_needsEvaluation || (stateId != m_currentStateId);
+	m_currentStateId = stateId;
+	m_currentSourceState = GetCurrentState();
+
+	if (UCreatureAnimState *newState = GetCurrentState())
+	{
+		newState->BeginState(this);
+	}
+}
+
+int32 UCreatureAnimStateMachineInstance::FindTransitionTarget() const
+{
+	const FCreatureCompiledState& state = TargetStateMachine->CompiledStates[m_currentStateId];
+	for (int32 i = state.FirstTransition; i < state.FirstTransition + state.NumTransitions; i++)
+	{
+		const FCreatureCompiledTransition& tran = TargetStateMachine->CompiledTransitions[i];
+		bool passes = true;
+		for (int32 j = tran.FirstCondition; passes && (j < tran.FirstCondition + tran.NumConditions); j++)
+		{
+			const FCreatureCompiledCondition& condition = TargetStateMachine->CompiledConditions[j];
+			passes = (m_conditionBits[condition.ConditionId] == condition.Flag);
+		}
+
+		if (passes)
+		{
+			return tran.TargetState;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+void UCreatureAnimStateMachineInstance::EvaluatePendingTransitions()
+{
+	if ((TargetStateMachine == nullptr) || !m_needsEvaluation)
+	{
+		return;
+	}
+
+	SyncCompiledTable();
+
+	m_needsEvaluation = false;
+	if (!TargetStateMachine->CompiledStates.IsValidIndex(m_currentStateId))
+	{
+		return;
+	}
+
+	const int32 targetState = FindTransitionTarget();
+	if (targetState != INDEX_NONE)
+	{
+		SetCurrentStateId(targetState);
+	}
+}
+
+void UCreatureAnimStateMachineInstance::SyncCompiledTable()
+{
+	if (m_compiledSerial == TargetStateMachine->CompiledSerial)
+	{
+		return;
+	}
+
+	m_compiledSerial = TargetStateMachine->CompiledSerial;
+
+	// Condition ids are reassigned by a compile, so the values move over by name
+	for (int32 i = 0; i < m_conditionNames.Num(); i++)
+	{
+		m_unusedConditions.Add(m_conditionNames[i], m_conditionBits[i]);
+	}
+
+	const int32 numConditions = TargetStateMachine->ConditionIds.Num();
+	m_conditionNames.SetNum(numConditions);
+	m_conditionBits.Init(false, numConditions);
+	for (const auto& conditionPair : TargetStateMachine->ConditionIds)
+	{
+		m_conditionNames[conditionPair.Value] = conditionPair.Key;
+
+		bool conditionFlag = false;
+		if (m_unusedConditions.RemoveAndCopyValue(conditionPair.Key, conditionFlag))
+		{
+			m_conditionBits[conditionPair.Value] = conditionFlag;
+		}
+	}
+
+	// So are the state ids
+	if (m_currentStateId != INDEX_NONE)
+	{
+		UCreatureAnimState *currentState = m_currentSourceState.Get();
+		const int32 remappedId = TargetStateMachine->CompiledStates.IndexOfByPredicate([currentState](const FCreatureCompiledState& compiledState) {
+			return compiledState.SourceState == currentState;
+		});
+
+		m_currentStateId = ((currentState != nullptr) && (remappedId != INDEX_NONE)) ? remappedId : TargetStateMachine->CompiledEntryState;
+		m_currentSourceState = GetCurrentState();
+	}
+
+	m_needsEvaluation = true;
+}
+
+void UCreatureAnimStateMachineInstance::SetLayer(FName LayerName, FName AnimationName, float Weight, bool Additive, const TArray<FName>& MaskBones, bool MaskChildren)
+{
+	UCreatureMeshComponent *owningComponent = GetOwningMeshComponent();
+	if ((owningComponent == nullptr) || (owningComponent->GetCore().GetCreatureManager() == nullptr))
+	{
+		return;
+	}
+
+	int32 layerIndex = m_layerNames.Find(LayerName);
+	if (layerIndex == INDEX_NONE)
+	{
+		layerIndex = m_layerNames.Add(LayerName);
+		m_layers.AddDefaulted();
+	}
+
+	CreatureModule::CreatureBlendLayer& layer = m_layers[layerIndex];
+	layer.animation_name = AnimationName;
+	layer.weight = Weight;
+	layer.additive = Additive;
+
+	// Unique across layers, so a layer moving to another index after ClearLayer still counts as restarted
+	static int32 nextPlaySerial = 0;
+	layer.play_serial = ++nextPlaySerial;
+
+	layer.bone_mask.Reset();
+	if (MaskBones.Num() > 0)
+	{
+		TMap<FName, float> maskWeights;
+		for (const FName& boneName : MaskBones)
+		{
+			maskWeights.Add(boneName, 1.0f);
+		}
+
+		owningComponent->GetCore().GetCreatureManager()->MakeBoneMask(maskWeights, MaskChildren, layer.bone_mask);
+	}
+
+	PushLayers();
+}
+
+void UCreatureAnimStateMachineInstance::SetLayerWeight(FName LayerName, float Weight)
+{
+	int32 layerIndex = m_layerNames.Find(LayerName);
+	if ((layerIndex == INDEX_NONE) || (m_layers[layerIndex].weight == Weight))
+	{
+		return;
+	}
+
+	m_layers[layerIndex].weight = Weight;
+	PushLayers();
+}
+
+void UCreatureAnimStateMachineInstance::ClearLayer(FName LayerName)
+{
+	int32 layerIndex = m_layerNames.Find(LayerName);
+	if (layerIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	m_layerNames.RemoveAt(layerIndex);
+	m_layers.RemoveAt(layerIndex);
+	PushLayers();
+}
+
+void UCreatureAnimStateMachineInstance::PushLayers()
+{
+	UCreatureMeshComponent *owningComponent = GetOwningMeshComponent();
+	if (owningComponent)
+	{
+		owningComponent->GetCore().SetBlendLayers(m_layers);
 	}
 }
 
@@ -69,6 +292,18 @@ void UCreatureAnimStateMachineInstance::InitInstance(UCreatureAnimStateMachine*
 {
 	check(forStateMachine);
 	TargetStateMachine = forStateMachine;
+	if (TargetStateMachine->CompiledSerial == 0)
+	{
+		TargetStateMachine->CompileTransitionTable();
+	}
+
+	m_conditionBits.Reset();
+	m_conditionNames.Reset();
+	m_unusedConditions.Reset();
+	m_currentStateId = INDEX_NONE;
+	m_currentSourceState = nullptr;
+	m_compiledSerial = 0;
+	SyncCompiledTable();
 
 	//󶨶ʼβ¼MeshComponent֧AnimStart/AnimEndת
 	UCreatureMeshComponent *owningComponent = GetOwningMeshComponent();
@@ -79,7 +314,7 @@ void UCreatureAnimStateMachineInstance::InitInstance(UCreatureAnimStateMachine*
 	}
 
 	//ʱʹãֱӴӸڵһڵ
-	SetCurrentState(forStateMachine->RootState->TransitionList[0]->TargetState);
+	SetCurrentStateId(TargetStateMachine->CompiledEntryState);
 }
 
 void UCreatureAnimStateMachineInstance::OnAnimStart(float frame)
@@ -92,5 +327,19 @@ void UCreatureAnimStateMachineInstance::OnAnimEnd(float frame)
 {
 	//SetCondition(FString(TEXT("AnimationStart")), false);
 	//SetCondition(FString(TEXT("AnimationEnd")), true);
-	CurrentState->AnimationEnd(this);
+	if ((TargetStateMachine == nullptr) || !TargetStateMachine->CompiledStates.IsValidIndex(m_currentStateId))
+	{
+		return;
+	}
+
+	// The first AnimationEnd transition of the current state is taken
+	const FCreatureCompiledState& state = TargetStateMachine->CompiledStates[m_currentStateId];
+	for (int32 i = state.FirstTransition; i < state.FirstTransition + state.NumTransitions; i++)
+	{
+		if (TargetStateMachine->CompiledTransitions[i].OnAnimationEnd)
+		{
+			SetCurrentStateId(TargetStateMachine->CompiledTransitions[i].TargetState);
+			return;
+		}
+	}
 }
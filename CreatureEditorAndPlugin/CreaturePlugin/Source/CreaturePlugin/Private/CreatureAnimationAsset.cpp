@@ -119,7 +119,27 @@ void UCreatureAnimationAsset::LoadPointCacheForClip(const FName &animName, class
 	if (cacheForAnim && forCore->GetCreatureManager())
 	{
 		CreatureModule::CreatureAnimation *anim = forCore->GetCreatureManager()->GetAnimation(animName);
-		if (anim == nullptr || anim->hasCachePts())
+		if (anim == nullptr)
+		{
+			return;
+		}
+
+		auto &frameBounds = anim->getFrameBounds();
+		if (frameBounds.Num() == 0)
+		{
+			frameBounds.SetNum(cacheForAnim->m_frameBounds.Num());
+			for (int32 i = 0; i < cacheForAnim->m_frameBounds.Num(); i++)
+			{
+				const FBox2D &srcBounds = cacheForAnim->m_frameBounds[i];
+				if (srcBounds.bIsValid)
+				{
+					frameBounds[i].add(srcBounds.Min.X, srcBounds.Min.Y);
+					frameBounds[i].add(srcBounds.Max.X, srcBounds.Max.Y);
+				}
+			}
+		}
+
+		if (anim->hasCachePts())
 		{
 			return;
 		}
@@ -200,19 +220,35 @@ void UCreatureAnimationAsset::PostLoad()
 		if (CreatureZipBinary.Num() != 0 || CreatureFileJSonData.IsEmpty() == false)
 		{
 			// load the animation data caches from the json data
-			GatherAnimationData();
+			GatherAnimationData(false);
 		}
 	}
 	else {
 		if (CreatureRawJSONString.Len() > 0)
 		{
 			// load the animation data caches from the json data
-			GatherAnimationData();
+			GatherAnimationData(false);
 		}
 	}
 }
 
-void UCreatureAnimationAsset::GatherAnimationData()
+static void AddCachePtsToFrameBounds(const TArray<glm::float32 *> &pts, int32 numPoints, TArray<FBox2D> &frameBounds)
+{
+	while (frameBounds.Num() < pts.Num())
+	{
+		frameBounds.Add(FBox2D(ForceInit));
+	}
+
+	for (int32 i = 0; i < pts.Num(); i++)
+	{
+		for (int32 j = 0; j < numPoints; j++)
+		{
+			frameBounds[i] += FVector2D(pts[i][j * 3], pts[i][(j * 3) + 1]);
+		}
+	}
+}
+
+void UCreatureAnimationAsset::GatherAnimationData(bool bake_frame_bounds)
 {
 	// ensure the filenames are synced
 	creature_filename = UpdateAndGetCreatureFilename();
@@ -225,7 +261,18 @@ void UCreatureAnimationAsset::GatherAnimationData()
 
 	auto all_animation_names = creature_core.GetCreatureManager()->GetCreature()->GetAnimationNames();
 
-	int32 arraySize = creature_core.GetCreatureManager()->GetCreature()->GetTotalNumPoints() * 3;
+	int32 numPoints = creature_core.GetCreatureManager()->GetCreature()->GetTotalNumPoints();
+	int32 arraySize = numPoints * 3;
+
+	// Frame bounds baked when the asset was saved, kept instead of posing every frame again
+	TMap<FName, TArray<FBox2D>> saved_frame_bounds;
+	if (!bake_frame_bounds)
+	{
+		for (FCreatureAnimationDataCache &oldCache : m_dataCache)
+		{
+			saved_frame_bounds.Add(oldCache.m_animationName, MoveTemp(oldCache.m_frameBounds));
+		}
+	}
 
 	m_dataCache.Reset(all_animation_names.Num());
 
@@ -238,6 +285,23 @@ void UCreatureAnimationAsset::GatherAnimationData()
 			animDataCache.m_animationName = cur_name;
 			animDataCache.m_length = anim->getEndTime() - anim->getStartTime();
 
+			// Bake the bounds of every exactly posed frame, an approximated point cache is added on top below
+			// since its interpolated frames can reach outside of the exact ones.
+			// Without a point cache nothing is baked, the Baked bounds mode then falls back to the posed bounds.
+			const bool isExactCache = (m_pointsCacheApproximationLevel == 0) || (m_pointsCacheApproximationLevel == 1);
+			TArray<FBox2D> *savedBounds = saved_frame_bounds.Find(cur_name);
+			if (savedBounds && (m_pointsCacheApproximationLevel >= 0))
+			{
+				animDataCache.m_frameBounds = MoveTemp(*savedBounds);
+			}
+			else if (bake_frame_bounds && !isExactCache && (m_pointsCacheApproximationLevel >= 0))
+			{
+				creature_core.GetCreatureManager()->ClearPointCache(cur_name);
+				creature_core.GetCreatureManager()->MakePointCache(cur_name, 1);
+				AddCachePtsToFrameBounds(anim->getCachePts(), numPoints, animDataCache.m_frameBounds);
+				creature_core.GetCreatureManager()->ClearPointCache(cur_name);
+			}
+
 			if (m_pointsCacheApproximationLevel >= 0)
 			{
 				creature_core.GetCreatureManager()->ClearPointCache(cur_name);
@@ -259,6 +323,17 @@ void UCreatureAnimationAsset::GatherAnimationData()
 							animDataCache.m_points.Add(pt[i]);
 						}
 					}
+
+					AddCachePtsToFrameBounds(pts, numPoints, animDataCache.m_frameBounds);
+				}
+			}
+
+			animDataCache.m_clipBounds = FBox2D(ForceInit);
+			for (const FBox2D &frameBounds : animDataCache.m_frameBounds)
+			{
+				if (frameBounds.bIsValid)
+				{
+					animDataCache.m_clipBounds += frameBounds;
 				}
 			}
 		}
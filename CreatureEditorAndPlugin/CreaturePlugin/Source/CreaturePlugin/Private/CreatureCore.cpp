@@ -1,6 +1,8 @@
 
 #include "CreaturePluginPCH.h"
 #include "CreatureMetaAsset.h"
+#include "CreaturePoseCache.h"
+#include "CreatureAllocationCheck.h"
 
 DECLARE_CYCLE_STAT(TEXT("CreatureCore_RunTick"), STAT_CreatureCore_RunTick, STATGROUP_Creature);
 DECLARE_CYCLE_STAT(TEXT("CreatureCore_UpdateCreatureRender"), STAT_CreatureCore_UpdateCreatureRender, STATGROUP_Creature);
@@ -8,6 +10,10 @@ DECLARE_CYCLE_STAT(TEXT("CreatureCore_FillBoneData"), STAT_CreatureCore_FillBone
 DECLARE_CYCLE_STAT(TEXT("CreatureCore_ParseEvents"), STAT_CreatureCore_ParseEvents, STATGROUP_Creature);
 DECLARE_CYCLE_STAT(TEXT("CreatureCore_UpdateManager"), STAT_CreatureCore_UpdateManager, STATGROUP_Creature);
 DECLARE_CYCLE_STAT(TEXT("CreatureCore_SetActiveAnimation"), STAT_CreatureCore_SetActiveAnimation, STATGROUP_Creature);
+DECLARE_CYCLE_STAT(TEXT("CreatureCore_ApplySharedPose"), STAT_CreatureCore_ApplySharedPose, STATGROUP_Creature);
+
+// Ticks of a new animation that may still grow the scratch memory before it counts as a steady state
+static const int32 CREATURE_STEADY_TICKS = 2;
 
 static TMap<FName, TSharedPtr<CreatureModule::CreatureAnimation> > global_animations;
 static TMap<FName, TSharedPtr<CreatureModule::CreatureLoadDataPacket> > global_load_data_packets;
@@ -47,10 +53,26 @@ CreatureCore::CreatureCore()
 	should_process_animation_start = false;
 	should_process_animation_end = false;
 	should_update_render_indices = false;
+	should_update_render_attributes = false;
+	use_shared_bone_pts = false;
+	uvs_animated_last = false;
+	skin_into_render_staging = false;
+	use_clip_bounds = false;
+	blend_layers_dirty = false;
+	use_shared_pose_cache = false;
+	shared_pose_time_step = 0.25f;
+	pose_unchanged = false;
+	pose_key_valid = false;
+	steady_tick_count = 0;
+	render_staging_serial = 0;
 	meta_data = nullptr;
 	global_indices_copy = nullptr;
 	skin_swap_active = false;
 	region_order_indices_num = 0;
+	applied_region_order = nullptr;
+	region_order_meta_data = nullptr;
+	region_order_meta_serial = 0;
+	region_order_applied = false;
 	update_lock = TSharedPtr<FCriticalSection, ESPMode::ThreadSafe>(new FCriticalSection());
 }
 
@@ -101,6 +123,9 @@ CreatureCore::GetProcMeshData(EWorldType::Type world_type)
 		return ret_data;
 	}
 
+	// New render data starts from the current points, so the next update has to pose and fill it
+	InvalidatePoseCache();
+
 	auto cur_creature = creature_manager->GetCreature();
 	int32 num_points = cur_creature->GetTotalNumPoints();
 	int32 num_indices = cur_creature->GetTotalNumIndices();
@@ -110,6 +135,8 @@ CreatureCore::GetProcMeshData(EWorldType::Type world_type)
 
 	glm::uint32 * copy_indices = GetIndicesCopy(num_indices);
 	std::memcpy(copy_indices, cur_idx, sizeof(glm::uint32) * num_indices);
+	region_order_applied = false;
+	region_order_meta_data = nullptr;
 
 	if (region_alphas.Num() != num_points)
 	{
@@ -124,16 +151,87 @@ CreatureCore::GetProcMeshData(EWorldType::Type world_type)
 		}
 	}
 
+	FCreatureStagingPointsPtr staging_pts;
+	if (skin_into_render_staging)
+	{
+		SetupRenderStaging();
+		staging_pts = render_staging_frames;
+	}
+	else {
+		creature_manager->ClearRenderPointsSink();
+	}
+
 	FProceduralMeshTriData ret_data(copy_indices,
 		cur_pts, cur_uvs,
 		num_points, num_indices,
 		&region_alphas,
-		update_lock);
+		update_lock,
+		staging_pts);
 
 	return ret_data;
 }
 
-void CreatureCore::UpdateCreatureRender()
+void CreatureCore::SetupRenderStaging()
+{
+	FScopeLock scope_lock(update_lock.Get());
+
+	auto cur_creature = creature_manager->GetCreature();
+	int32 num_points = cur_creature->GetTotalNumPoints();
+	glm::float32 * cur_pts = cur_creature->GetRenderPts();
+
+	TArray<FVector> start_pts;
+	start_pts.SetNumUninitialized(num_points);
+	render_pts_z.SetNumUninitialized(num_points);
+	render_pts_next_z.SetNumUninitialized(num_points);
+
+	// Start off from the current render points, swizzled the same way as the render packet
+	for (int32 i = 0; i < num_points; i++)
+	{
+		glm::float32 * read_pt = cur_pts + (i * 3);
+		start_pts[i] = FVector(read_pt[0], read_pt[2], read_pt[1]);
+		render_pts_z[i] = read_pt[2];
+	}
+
+	// The render packet of the last render data may still be reading the old buffers
+	render_staging_frames = FCreatureStagingPointsPtr(new TCreatureRenderTripleBuffer<TArray<FVector>>());
+	render_staging_frames->Init(start_pts);
+	render_staging_serial = creature_manager->GetRenderPointsSerial();
+
+	creature_manager->SetRenderPointsSink(
+		meshPointsSink((glm::float32 *)render_staging_frames->GetWriteBuffer().GetData(), 3, 0, 2, 1, render_pts_z.GetData()));
+}
+
+void CreatureCore::PublishRenderStaging(bool depths_changed)
+{
+	// Posing refills the whole write buffer, otherwise it has to start off from the last published points
+	bool was_posed = (creature_manager->GetRenderPointsSerial() != render_staging_serial);
+	if (!was_posed && !depths_changed)
+	{
+		return;
+	}
+
+	TArray<FVector>& write_pts = render_staging_frames->GetWriteBuffer();
+	if (!was_posed)
+	{
+		write_pts = render_staging_frames->GetLastPublished();
+	}
+
+	if (depths_changed)
+	{
+		for (int32 i = 0; i < write_pts.Num(); i++)
+		{
+			write_pts[i].Y = render_pts_z[i];
+		}
+	}
+
+	render_staging_frames->Publish();
+	render_staging_serial = creature_manager->GetRenderPointsSerial();
+
+	creature_manager->SetRenderPointsSink(
+		meshPointsSink((glm::float32 *)render_staging_frames->GetWriteBuffer().GetData(), 3, 0, 2, 1, render_pts_z.GetData()));
+}
+
+void CreatureCore::UpdateCreatureRender(const TArray<uint8> * shared_alphas_in)
 {
 	SCOPE_CYCLE_COUNTER(STAT_CreatureCore_UpdateCreatureRender);
 
@@ -144,8 +242,19 @@ void CreatureCore::UpdateCreatureRender()
 	glm::float32 * cur_pts = cur_creature->GetRenderPts();
 	glm::float32 * cur_uvs = cur_creature->GetGlobalUvs();
 	should_update_render_indices = false;
+	should_update_render_attributes = false;
 	region_order_indices_num = 0;
 
+	// Region depths go straight into the render points, or into a z table when posing writes into the render staging points
+	bool use_staging = skin_into_render_staging && render_staging_frames.IsValid()
+		&& (render_staging_frames->GetLastPublished().Num() == cur_creature->GetTotalNumPoints());
+	meshPointsSink z_sink(cur_pts);
+	if (use_staging)
+	{
+		z_sink = meshPointsSink(render_pts_next_z.GetData(), 1, 0, 0, 0);
+		FMemory::Memcpy(render_pts_next_z.GetData(), render_pts_z.GetData(), render_pts_z.Num() * sizeof(glm::float32));
+	}
+
 	// Update depth per region
 	TArray<meshRenderRegion *>& cur_regions =
 		cur_creature->GetRenderComposition()->getRegions();
@@ -156,11 +265,10 @@ void CreatureCore::UpdateCreatureRender()
 		// Normal update in default order
 		for (auto& single_region : cur_regions)
 		{
-			glm::float32 * region_pts = cur_pts + (single_region->getStartPtIndex() * 3);
-			for (size_t i = 0; i < single_region->getNumPts(); i++)
+			meshPointsSink region_sink = z_sink.offset(single_region->getStartPtIndex());
+			for (int32 i = 0; i < single_region->getNumPts(); i++)
 			{
-				region_pts[2] = region_z;
-				region_pts += 3;
+				region_sink.setZ(i, region_z);
 			}
 
 			region_z += delta_z;
@@ -177,24 +285,48 @@ void CreatureCore::UpdateCreatureRender()
 					skin_swap_indices.GetData(),
 					skin_swap_indices.GetData() + skin_swap_indices.Num(),
 					dst_indices);
+
+				region_order_applied = false;
+				should_update_render_indices = true;
 			}
 			else {
 				// Region Layer Ordering Animation
+				if (meta_animation_name != creature_manager->GetActiveAnimationName())
+				{
+					meta_animation_name = creature_manager->GetActiveAnimationName();
+					meta_animation_name_string = meta_animation_name.ToString();
+				}
+
+				// A rebuilt or replaced meta data can sit at the same address, its serial tells them apart
+				if ((region_order_meta_data != meta_data) || (region_order_meta_serial != meta_data->getSerial()))
+				{
+					meta_data->buildRegionPointRanges(cur_idx, cur_num_indices, region_order_pt_ranges);
+					region_order_meta_data = meta_data;
+					region_order_meta_serial = meta_data->getSerial();
+					region_order_applied = false;
+				}
+
+				// Layer orders switch a few times per clip, the indices are only rebuilt and uploaded when they do
 				int cur_runtime = (int)(creature_manager->getActualRunTime());
+				auto cur_order = meta_data->sampleOrder(meta_animation_name_string, cur_runtime);
+				bool order_changed = !region_order_applied || (cur_order != applied_region_order);
 				region_order_indices_num = meta_data->updateIndicesAndPoints(
 					dst_indices,
 					cur_creature->GetGlobalIndices(),
-					cur_pts,
+					z_sink,
 					delta_z,
 					cur_creature->GetTotalNumIndices(),
 					cur_creature->GetTotalNumPoints(),
-					creature_manager->GetActiveAnimationName().ToString(),
+					cur_order,
+					region_order_pt_ranges,
+					order_changed,
 					shouldSkinSwap(),
-					skin_swap_region_ids,
-					cur_runtime);
-			}
+					skin_swap_region_ids);
 
-			should_update_render_indices = true;
+				applied_region_order = cur_order;
+				region_order_applied = true;
+				should_update_render_indices = order_changed;
+			}
 		}
 	}
 	else {
@@ -209,11 +341,10 @@ void CreatureCore::UpdateCreatureRender()
 			if (regions_map.Contains(real_name))
 			{
 				auto single_region = regions_map[real_name];
-				glm::float32 * region_pts = cur_pts + (single_region->getStartPtIndex() * 3);
-				for (size_t i = 0; i < single_region->getNumPts(); i++)
+				meshPointsSink region_sink = z_sink.offset(single_region->getStartPtIndex());
+				for (int32 i = 0; i < single_region->getNumPts(); i++)
 				{
-					region_pts[2] = region_z;
-					region_pts += 3;
+					region_sink.setZ(i, region_z);
 				}
 
 				region_z += delta_z;
@@ -231,11 +362,25 @@ void CreatureCore::UpdateCreatureRender()
 			}
 		}
 
+		region_order_applied = false;
 		should_update_render_indices = true;
 	}
 
+	// Posing already wrote the depths of the previous order, only rewrite them if the order changed
+	if (use_staging)
+	{
+		bool depths_changed =
+			(FMemory::Memcmp(render_pts_next_z.GetData(), render_pts_z.GetData(), render_pts_z.Num() * sizeof(glm::float32)) != 0);
+		if (depths_changed)
+		{
+			FMemory::Memcpy(render_pts_z.GetData(), render_pts_next_z.GetData(), render_pts_z.Num() * sizeof(glm::float32));
+		}
+
+		PublishRenderStaging(depths_changed);
+	}
+
 	// process the render regions
-	ProcessRenderRegions();
+	ProcessRenderRegions(shared_alphas_in);
 }
 
 bool CreatureCore::InitCreatureRender()
@@ -319,7 +464,7 @@ bool CreatureCore::InitCreatureRender()
 			creature_manager->SetAutoBlending(true);
 		}
 
-		FillBoneData();
+		InitBoneData();
 	}
 
 	is_animation_loaded = true;
@@ -333,79 +478,119 @@ void CreatureCore::InitValues()
 	meta_data = nullptr;
 }
 
-void CreatureCore::FillBoneData()
+void CreatureCore::InitBoneData()
 {
-	SCOPE_CYCLE_COUNTER(STAT_CreatureCore_FillBoneData);
+	auto& bones_map = creature_manager->GetCreature()->GetRenderComposition()->getBonesMap();
 
-	auto  render_composition = creature_manager->GetCreature()->GetRenderComposition();
-	auto& bones_map = render_composition->getBonesMap();
-
-	if (bone_data.Num() == 0)
+	bone_data_bones.Reset(bones_map.Num());
+	bone_data_indices.Reset();
+	bone_data.SetNum(bones_map.Num());
+	for (auto& cur_data : bones_map)
 	{
-		bone_data.SetNum(bones_map.Num());
+		bone_data[bone_data_bones.Num()].name = cur_data.Key;
+		bone_data_indices.Add(cur_data.Key, bone_data_bones.Num());
+		bone_data_bones.Add(cur_data.Value);
 	}
 
-	int i = 0;
-	for (auto& cur_data : bones_map)
+	use_shared_bone_pts = false;
+	MarkBoneDataDirty();
+}
+
+void CreatureCore::MarkBoneDataDirty()
+{
+	bone_data_valid.Init(false, bone_data.Num());
+}
+
+void CreatureCore::FillBoneData() const
+{
+	SCOPE_CYCLE_COUNTER(STAT_CreatureCore_FillBoneData);
+
+	FScopeLock scope_lock(update_lock.Get());
+	for (int32 i = 0; i < bone_data.Num(); i++)
 	{
-		bone_data[i].name = cur_data.Key;
+		GetBoneData(i);
+	}
+}
 
-		auto pt1 = cur_data.Value->getWorldStartPt();
-		auto pt2 = cur_data.Value->getWorldEndPt();
+void CreatureCore::GetBonePoints(int32 bone_idx, glm::vec4& start_pt_out, glm::vec4& end_pt_out) const
+{
+	if (use_shared_bone_pts)
+	{
+		start_pt_out = shared_bone_pts[bone_idx * 2];
+		end_pt_out = shared_bone_pts[bone_idx * 2 + 1];
+	}
+	else {
+		start_pt_out = bone_data_bones[bone_idx]->getWorldStartPt();
+		end_pt_out = bone_data_bones[bone_idx]->getWorldEndPt();
+	}
+}
 
-		/* Id References
-		const int x_id = 0;
-		const int y_id = 2;
-		const int z_id = 1;
-		*/
+int32 CreatureCore::GetBoneDataIndex(FName name_in) const
+{
+	const int32 * found_idx = bone_data_indices.Find(name_in);
+	return found_idx ? *found_idx : INDEX_NONE;
+}
 
-		bone_data[i].point1 = FVector(pt1.x, pt1.y, pt1.z);
-		bone_data[i].point2 = FVector(pt2.x, pt2.y, pt2.z);
+const FCreatureBoneData& CreatureCore::GetBoneData(int32 bone_idx) const
+{
+	FScopeLock scope_lock(update_lock.Get());
 
-		// figure out bone transform
-		auto cur_bone = cur_data.Value;
-		auto bone_start_pt = pt1;
-		auto bone_end_pt = pt2;
+	FCreatureBoneData& cur_data = bone_data[bone_idx];
+	if (bone_data_valid[bone_idx])
+	{
+		return cur_data;
+	}
 
-		auto bone_vec = bone_end_pt - bone_start_pt;
-		auto bone_length = glm::length(bone_vec);
-		auto bone_unit_vec = bone_vec / bone_length;
+	bone_data_valid[bone_idx] = true;
 
-		// quick rotation by 90 degrees
-		auto bone_unit_normal_vec = bone_unit_vec;
-		bone_unit_normal_vec.x = -bone_unit_vec.y;
-		bone_unit_normal_vec.y = bone_unit_vec.x;
+	glm::vec4 pt1, pt2;
+	GetBonePoints(bone_idx, pt1, pt2);
 
-		FVector bone_midpt = (bone_data[i].point1 + bone_data[i].point2) * 0.5f;
-		FVector bone_axis_x(bone_unit_vec.x, bone_unit_vec.y, 0);
-		FVector bone_axis_y(bone_unit_normal_vec.x, bone_unit_normal_vec.y, 0);
-		FVector bone_axis_z(0, 0, 1);
+	/* Id References
+	const int x_id = 0;
+	const int y_id = 2;
+	const int z_id = 1;
+	*/
 
-		FTransform scaleXform(FVector(0, 0, 0));
-		scaleXform.SetScale3D(FVector(bone_length * bone_data_length_factor, bone_data_size, bone_data_size));
+	cur_data.point1 = FVector(pt1.x, pt1.y, pt1.z);
+	cur_data.point2 = FVector(pt2.x, pt2.y, pt2.z);
 
+	// figure out bone transform
+	auto bone_vec = pt2 - pt1;
+	auto bone_length = glm::length(bone_vec);
+	auto bone_unit_vec = bone_vec / bone_length;
 
-		//std::swap(bone_midpt.Y, bone_midpt.Z);
+	// quick rotation by 90 degrees
+	auto bone_unit_normal_vec = bone_unit_vec;
+	bone_unit_normal_vec.x = -bone_unit_vec.y;
+	bone_unit_normal_vec.y = bone_unit_vec.x;
 
-		FTransform fixXform;
-		fixXform.SetRotation(FQuat::MakeFromEuler(FVector(-90, 0, 0)));
+	FVector bone_midpt = (cur_data.point1 + cur_data.point2) * 0.5f;
+	FVector bone_axis_x(bone_unit_vec.x, bone_unit_vec.y, 0);
+	FVector bone_axis_y(bone_unit_normal_vec.x, bone_unit_normal_vec.y, 0);
+	FVector bone_axis_z(0, 0, 1);
 
-		FTransform rotXform(bone_axis_x, bone_axis_y, bone_axis_z, FVector(0, 0, 0));
+	FTransform scaleXform(FVector(0, 0, 0));
+	scaleXform.SetScale3D(FVector(bone_length * bone_data_length_factor, bone_data_size, bone_data_size));
 
-		FTransform posXform, posStartXform, posEndXform;
-		posXform.SetTranslation(bone_midpt);
-		posStartXform.SetTranslation(bone_data[i].point1);
-		posEndXform.SetTranslation(bone_data[i].point2);
+	static const FQuat fix_rotation = FQuat::MakeFromEuler(FVector(-90, 0, 0));
+	FTransform fixXform;
+	fixXform.SetRotation(fix_rotation);
 
-		//		bone_data[i].xform = scaleXform * FTransform(bone_axis_x, bone_axis_y, bone_axis_z, bone_midpt);
-		bone_data[i].xform = scaleXform  * rotXform  * posXform * fixXform;
+	FTransform rotXform(bone_axis_x, bone_axis_y, bone_axis_z, FVector(0, 0, 0));
 
-		bone_data[i].startXform = scaleXform  * rotXform  * posStartXform * fixXform;
-		bone_data[i].endXform = scaleXform  * rotXform  * posEndXform * fixXform;
+	// The start, mid and end transforms only differ in their translation
+	const FTransform scaleRotXform = scaleXform * rotXform;
+	FTransform posXform, posStartXform, posEndXform;
+	posXform.SetTranslation(bone_midpt);
+	posStartXform.SetTranslation(cur_data.point1);
+	posEndXform.SetTranslation(cur_data.point2);
 
-		i++;
-	}
+	cur_data.xform = scaleRotXform * posXform * fixXform;
+	cur_data.startXform = scaleRotXform * posStartXform * fixXform;
+	cur_data.endXform = scaleRotXform * posEndXform * fixXform;
 
+	return cur_data;
 }
 
 void CreatureCore::ParseEvents(float deltaTime)
@@ -415,16 +600,8 @@ void CreatureCore::ParseEvents(float deltaTime)
 	float cur_runtime = (creature_manager->getActualRunTime());
 	animation_frame = cur_runtime;
 
-	auto load_filename = absolute_creature_filename;
-
-	auto cur_animation_name = creature_manager->GetActiveAnimationName();
-
-	auto cur_token = GetAnimationToken(load_filename, cur_animation_name);
-	CreatureModule::CreatureAnimation * cur_animation = NULL;
-	if (global_animations.Contains(cur_token))
-	{
-		cur_animation = global_animations[cur_token].Get();
-	}
+	// The manager holds the same animations as the global table, without building the token name every tick
+	CreatureModule::CreatureAnimation * cur_animation = creature_manager->GetAnimation(creature_manager->GetActiveAnimationName());
 
 
 	if (cur_animation)
@@ -458,7 +635,7 @@ void CreatureCore::ParseEvents(float deltaTime)
 
 }
 
-void CreatureCore::ProcessRenderRegions()
+void CreatureCore::ProcessRenderRegions(const TArray<uint8> * shared_alphas_in)
 {
 	auto cur_creature = creature_manager->GetCreature();
 	auto& regions_map = cur_creature->GetRenderComposition()->getRegionsMap();
@@ -470,43 +647,65 @@ void CreatureCore::ProcessRenderRegions()
 		region_alphas.Init(255, cur_creature->GetTotalNumPoints());
 	}
 
-	// fill up animation alphas
-	for (auto& cur_region_pair : regions_map)
+	// the region opacities were not posed for a shared pose, its alphas already have the user overwrites
+	if (shared_alphas_in)
 	{
-		auto cur_region = cur_region_pair.Value;
-		auto start_pt_index = cur_region->getStartPtIndex();
-		auto end_pt_index = cur_region->getEndPtIndex();
-		auto cur_alpha = FMath::Clamp(cur_region->getOpacity() / 100.0f, 0.0f, 1.0f) * 255.0f;
+		region_alphas = *shared_alphas_in;
+	}
+	else {
+		// fill up animation alphas
+		for (auto& cur_region_pair : regions_map)
+		{
+			auto cur_region = cur_region_pair.Value;
+			auto start_pt_index = cur_region->getStartPtIndex();
+			auto end_pt_index = cur_region->getEndPtIndex();
+			auto cur_alpha = FMath::Clamp(cur_region->getOpacity() / 100.0f, 0.0f, 1.0f) * 255.0f;
 
 
-		for (auto i = start_pt_index; i <= end_pt_index; i++)
-		{
-			region_alphas[i] = (uint8)cur_alpha;
+			for (auto i = start_pt_index; i <= end_pt_index; i++)
+			{
+				region_alphas[i] = (uint8)cur_alpha;
+			}
 		}
-	}
 
-	// user overwrite alphas
-	if (region_alpha_map.Num() > 0)
-	{
-		// fill up the alphas for specific regions with alpha overwrites
-		for (auto cur_iter : region_alpha_map)
+		// user overwrite alphas
+		if (region_alpha_map.Num() > 0)
 		{
-			auto cur_name = cur_iter.Key;
-			auto cur_alpha = cur_iter.Value;
-
-			if (regions_map.Contains(cur_name))
+			// fill up the alphas for specific regions with alpha overwrites
+			for (auto cur_iter : region_alpha_map)
 			{
-				meshRenderRegion * cur_region = regions_map[cur_name];
-				auto start_pt_index = cur_region->getStartPtIndex();
-				auto end_pt_index = cur_region->getEndPtIndex();
+				auto cur_name = cur_iter.Key;
+				auto cur_alpha = cur_iter.Value;
 
-				for (auto i = start_pt_index; i <= end_pt_index; i++)
+				if (regions_map.Contains(cur_name))
 				{
-					region_alphas[i] = cur_alpha;
+					meshRenderRegion * cur_region = regions_map[cur_name];
+					auto start_pt_index = cur_region->getStartPtIndex();
+					auto end_pt_index = cur_region->getEndPtIndex();
+
+					for (auto i = start_pt_index; i <= end_pt_index; i++)
+					{
+						region_alphas[i] = cur_alpha;
+					}
 				}
 			}
 		}
 	}
+
+	// uvs are rewritten every frame by uv warps and item swaps, one more update catches them being switched off
+	bool uvs_animated = (cur_creature->GetActiveItemSwaps().Num() > 0);
+	for (auto cur_region : cur_creature->GetRenderComposition()->getRegions())
+	{
+		uvs_animated = uvs_animated || cur_region->getUseUvWarp();
+	}
+
+	if (uvs_animated || uvs_animated_last || (last_region_alphas != region_alphas))
+	{
+		should_update_render_attributes = true;
+		last_region_alphas = region_alphas;
+	}
+
+	uvs_animated_last = uvs_animated;
 }
 
 bool 
@@ -629,6 +828,8 @@ CreatureCore::LoadCreature(const FName& filename_in)
 
 	creature_manager = TSharedPtr<CreatureModule::CreatureManager>(
 		new CreatureModule::CreatureManager(new_creature));
+	steady_animation_name = NAME_None;
+	steady_tick_count = 0;
 
 	draw_triangles.SetNum(creature_manager->GetCreature()->GetTotalNumIndices() / 3, true);
 
@@ -737,37 +938,32 @@ CreatureCore::ClearBluePrintPointCache(FName name_in, int32 approximation_level)
 
 FTransform 
 CreatureCore::GetBluePrintBoneXform(FName name_in, bool world_transform, float position_slide_factor, const FTransform& base_transform) const
+{
+	return GetBoneXform(GetBoneDataIndex(name_in), world_transform, position_slide_factor, base_transform);
+}
+
+FTransform
+CreatureCore::GetBoneXform(int32 bone_idx, bool world_transform, float position_slide_factor, const FTransform& base_transform) const
 {
 	FTransform ret_xform;
-	for (size_t i = 0; i < bone_data.Num(); i++)
+	if (!bone_data.IsValidIndex(bone_idx))
 	{
-		if (bone_data[i].name == name_in)
-		{
-			ret_xform = bone_data[i].xform;
-			float diff_slide_factor = fabs(position_slide_factor);
-			const float diff_cutoff = 0.01f;
-			if (diff_slide_factor > diff_cutoff)
-			{
-				// interpolate between start and end
-				ret_xform.Blend(bone_data[i].startXform, bone_data[i].endXform, position_slide_factor + 0.5f);
-			}
-
+		return ret_xform;
+	}
 
-			if (world_transform)
-			{
-				FTransform xform = base_transform;
-				/*
-				FVector world_location = xform.GetTranslation();
-				ret_data.point1 = xform.TransformPosition(ret_data.point1);
-				ret_data.point2 = xform.TransformPosition(ret_data.point2);
-				*/
-				//FMatrix no_scale = xform.ToMatrixNoScale();
-
-				ret_xform = ret_xform * xform;
-			}
+	const FCreatureBoneData& cur_data = GetBoneData(bone_idx);
+	ret_xform = cur_data.xform;
+	float diff_slide_factor = fabs(position_slide_factor);
+	const float diff_cutoff = 0.01f;
+	if (diff_slide_factor > diff_cutoff)
+	{
+		// interpolate between start and end
+		ret_xform.Blend(cur_data.startXform, cur_data.endXform, position_slide_factor + 0.5f);
+	}
 
-			break;
-		}
+	if (world_transform)
+	{
+		ret_xform = ret_xform * base_transform;
 	}
 
 	return ret_xform;
@@ -783,15 +979,14 @@ CreatureCore::IsBluePrintBonesCollide(FVector test_point, float bone_size, const
 
 	FTransform xform = base_transform;
 	FVector local_test_point = xform.InverseTransformPosition(test_point);
-	auto  render_composition = creature_manager->GetCreature()->GetRenderComposition();
-	auto& bones_map = render_composition->getBonesMap();
+
+	FScopeLock scope_lock(update_lock.Get());
 
 	glm::vec4 real_test_pt(local_test_point.X, local_test_point.Y, local_test_point.Z, 1.0f);
-	for (auto cur_data : bones_map)
+	for (int32 bone_idx = 0; bone_idx < bone_data_bones.Num(); bone_idx++)
 	{
-		auto cur_bone = cur_data.Value;
-		auto bone_start_pt = cur_bone->getWorldStartPt();
-		auto bone_end_pt = cur_bone->getWorldEndPt();
+		glm::vec4 bone_start_pt, bone_end_pt;
+		GetBonePoints(bone_idx, bone_start_pt, bone_end_pt);
 
 		auto bone_vec = bone_end_pt - bone_start_pt;
 		auto bone_length = glm::length(bone_vec);
@@ -831,10 +1026,13 @@ CreatureCore::RunTick(float delta_time)
 
 	FScopeLock scope_lock(update_lock.Get());
 
+	pose_unchanged = false;
+
 	if (is_driven)
 	{
 		UpdateCreatureRender();
-		FillBoneData();
+		use_shared_bone_pts = false;
+		MarkBoneDataDirty();
 
 		return true;
 	}
@@ -846,16 +1044,81 @@ CreatureCore::RunTick(float delta_time)
 
 	if (creature_manager.Get())
 	{
+#if !UE_BUILD_SHIPPING
+		FCreatureScopedAllocationCheck allocation_check(TEXT("CreatureCore::RunTick"), UpdateSteadyTickCount());
+#endif
+
 		ParseEvents(delta_time);
 
+		if (should_play) {
+			creature_manager->SetUseClipBounds(use_clip_bounds);
+			creature_manager->SetLodSettings(lod_settings);
+			if (blend_layers_dirty)
+			{
+				creature_manager->SetBlendLayers(blend_layers);
+				blend_layers_dirty = false;
+			}
+
+			creature_manager->AdvanceTime(delta_time);
+		}
+
+		// Paused or otherwise idle, the last posed points and render data are still current
+		pose_unchanged = UpdatePoseInputKey();
+		if (pose_unchanged)
+		{
+			return true;
+		}
+
+		// Another instance may already have posed this character at about the same time this frame
+		const bool can_share = use_shared_pose_cache && should_play && MakeSharedPoseKey(shared_pose_key);
+		if (can_share && ApplySharedPose(shared_pose_key))
+		{
+			return true;
+		}
+
 		if (should_play) {
 			SCOPE_CYCLE_COUNTER(STAT_CreatureCore_UpdateManager);
-			creature_manager->Update(delta_time);
+			creature_manager->PoseCurrentTime();
+		}
+
+		FCreatureSharedPosePtr new_shared_pose;
+		if (can_share)
+		{
+			auto cur_creature = creature_manager->GetCreature();
+			const int32 num_points = cur_creature->GetTotalNumPoints();
+			const meshPointsSink posed_sink = creature_manager->GetRenderPointsSink();
+
+			new_shared_pose = FCreaturePoseCache::Acquire();
+			new_shared_pose->posed_pts.SetNumUninitialized(num_points * 2);
+			for (int32 i = 0; i < num_points; i++)
+			{
+				const glm::float32 * read_pt = posed_sink.getPt(i);
+				new_shared_pose->posed_pts[i * 2] = read_pt[posed_sink.x_id];
+				new_shared_pose->posed_pts[i * 2 + 1] = read_pt[posed_sink.y_id];
+			}
+
+			new_shared_pose->posed_bounds = creature_manager->GetRenderPointsBounds();
 		}
 
 		UpdateCreatureRender();
 
-		FillBoneData();
+		use_shared_bone_pts = false;
+		MarkBoneDataDirty();
+
+		// Uv animation only shows up once the render regions are processed
+		if (new_shared_pose.IsValid() && !uvs_animated_last)
+		{
+			// Pooled poses may have held another character, copies keep their memory instead of matching its size
+			new_shared_pose->region_alphas.Reset(region_alphas.Num());
+			new_shared_pose->region_alphas.Append(region_alphas);
+			new_shared_pose->bone_pts.SetNumUninitialized(bone_data_bones.Num() * 2);
+			for (int32 i = 0; i < bone_data_bones.Num(); i++)
+			{
+				GetBonePoints(i, new_shared_pose->bone_pts[i * 2], new_shared_pose->bone_pts[i * 2 + 1]);
+			}
+
+			FCreaturePoseCache::Add(shared_pose_key, new_shared_pose);
+		}
 
 	}
 
@@ -921,6 +1184,33 @@ void CreatureCore::SetBluePrintAnimationResetToEnd()
 	play_end_done = false;
 }
 
+bool
+CreatureCore::RunClockTick(float delta_time)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CreatureCore_RunTick);
+
+	if (!is_animation_loaded || is_driven || is_disabled || !creature_manager.Get())
+	{
+		return false;
+	}
+
+	FScopeLock scope_lock(update_lock.Get());
+
+	ParseEvents(delta_time);
+
+	if (should_play) {
+		if (blend_layers_dirty)
+		{
+			creature_manager->SetBlendLayers(blend_layers);
+			blend_layers_dirty = false;
+		}
+
+		creature_manager->AdvanceTime(delta_time);
+	}
+
+	return true;
+}
+
 float
 CreatureCore::GetBluePrintAnimationFrame()
 {
@@ -951,7 +1241,7 @@ void CreatureCore::RemoveBluePrintRegionAlpha(FName region_name_in)
 }
 
 void 
-CreatureCore::SetBluePrintRegionCustomOrder(TArray<FName> order_in)
+CreatureCore::SetBluePrintRegionCustomOrder(const TArray<FName>& order_in)
 {
 	region_custom_order = order_in;
 }
@@ -990,6 +1280,120 @@ CreatureCore::SetActiveAnimation(const FName& name_in)
 	creature_manager->SetAutoBlending(false);
 }
 
+void
+CreatureCore::InvalidatePoseCache()
+{
+	pose_key_valid = false;
+}
+
+bool
+CreatureCore::MakePoseInputKey(CreatureModule::CreaturePoseKey& key_out, float time_step)
+{
+	key_out.reset();
+	bool can_cache = creature_manager->GetPoseInputKey(key_out, time_step);
+
+	key_out.add(should_play ? 1 : 0);
+	key_out.add(skin_swap_active ? 1 : 0);
+	key_out.addString(skin_swap_name);
+	key_out.addFloat(region_overlap_z_delta);
+	key_out.add((uint32)region_custom_order.Num());
+	for (const FName& cur_name : region_custom_order)
+	{
+		key_out.addName(cur_name);
+	}
+
+	key_out.add((uint32)region_alpha_map.Num());
+	for (const auto& cur_alpha : region_alpha_map)
+	{
+		key_out.addName(cur_alpha.Key);
+		key_out.add((uint32)cur_alpha.Value);
+	}
+
+	return can_cache;
+}
+
+bool
+CreatureCore::UpdatePoseInputKey()
+{
+	const bool can_cache = MakePoseInputKey(next_pose_key, 0.0f);
+
+	const bool is_unchanged = can_cache && pose_key_valid && (next_pose_key == last_pose_key);
+	Swap(next_pose_key, last_pose_key);
+	pose_key_valid = can_cache;
+
+	return is_unchanged;
+}
+
+bool
+CreatureCore::UpdateSteadyTickCount()
+{
+	const FName& cur_name = creature_manager->GetActiveAnimationName();
+	if (cur_name != steady_animation_name)
+	{
+		steady_animation_name = cur_name;
+		steady_tick_count = 0;
+	}
+	else if (steady_tick_count < CREATURE_STEADY_TICKS)
+	{
+		steady_tick_count++;
+	}
+
+	return steady_tick_count >= CREATURE_STEADY_TICKS;
+}
+
+bool
+CreatureCore::MakeSharedPoseKey(CreatureModule::CreaturePoseKey& key_out)
+{
+	// Blend layers and uv animation are set up per instance, so their poses are never the same
+	if (creature_manager->HasActiveBlendLayers() || uvs_animated_last || !MakePoseInputKey(key_out, shared_pose_time_step))
+	{
+		return false;
+	}
+
+	// Different characters can have the same inputs, the file keeps their poses apart
+	key_out.addName(absolute_creature_filename);
+	key_out.addFloat(shared_pose_time_step);
+	key_out.addFloat(bone_data_size);
+	key_out.addFloat(bone_data_length_factor);
+
+	return true;
+}
+
+bool
+CreatureCore::ApplySharedPose(const CreatureModule::CreaturePoseKey& key_in)
+{
+	FCreatureSharedPosePtr shared_pose = FCreaturePoseCache::Find(key_in);
+	auto cur_creature = creature_manager->GetCreature();
+	if (!shared_pose.IsValid()
+		|| (shared_pose->posed_pts.Num() != cur_creature->GetTotalNumPoints() * 2)
+		|| (shared_pose->bone_pts.Num() != bone_data_bones.Num() * 2))
+	{
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_CreatureCore_ApplySharedPose);
+
+	creature_manager->SetPosedPoints(shared_pose->posed_pts.GetData(), shared_pose->posed_bounds);
+	UpdateCreatureRender(&shared_pose->region_alphas);
+
+	// The bones of this instance were not posed, bone data is built from the shared bone points instead
+	shared_bone_pts.Reset(shared_pose->bone_pts.Num());
+	shared_bone_pts.Append(shared_pose->bone_pts);
+	use_shared_bone_pts = true;
+	MarkBoneDataDirty();
+
+	return true;
+}
+
+void
+CreatureCore::SetBlendLayers(const TArray<CreatureModule::CreatureBlendLayer>& layers_in)
+{
+	FScopeLock scope_lock(update_lock.Get());
+
+	blend_layers = layers_in;
+	blend_layers_dirty = true;
+}
+
 void 
 CreatureCore::SetAutoBlendActiveAnimation(const FName& name_in, float factor)
 {
@@ -1061,6 +1465,46 @@ glm::uint32 * CreatureCore::GetIndicesCopy(int init_size)
 	return global_indices_copy;
 }
 
+FBox CreatureCore::GetRenderBounds() const
+{
+	if (!creature_manager.IsValid() || is_driven)
+	{
+		return FBox(ForceInit);
+	}
+
+	return MakeRenderBounds(creature_manager->GetRenderPointsBounds());
+}
+
+FBox CreatureCore::GetBakedRenderBounds() const
+{
+	meshPointsBounds baked_bounds;
+	if (!creature_manager.IsValid() || is_driven || !creature_manager->GetBakedBounds(baked_bounds))
+	{
+		return FBox(ForceInit);
+	}
+
+	return MakeRenderBounds(baked_bounds);
+}
+
+FBox CreatureCore::MakeRenderBounds(const meshPointsBounds& bounds_in) const
+{
+	FBox ret_bounds(ForceInit);
+	if (!bounds_in.isValid())
+	{
+		return ret_bounds;
+	}
+
+	// Region depths run along Y from the first to the last region in either order
+	auto cur_creature = creature_manager->GetCreature();
+	float depth_extent = cur_creature->GetRenderComposition()->getRegions().Num() * region_overlap_z_delta;
+
+	ret_bounds.Min = FVector(bounds_in.min_pt.x, FMath::Min(0.0f, depth_extent), bounds_in.min_pt.y);
+	ret_bounds.Max = FVector(bounds_in.max_pt.x, FMath::Max(0.0f, depth_extent), bounds_in.max_pt.y);
+	ret_bounds.IsValid = 1;
+
+	return ret_bounds;
+}
+
 int32 CreatureCore::GetRealTotalIndicesNum() const
 {
 	auto cur_creature = creature_manager->GetCreature();
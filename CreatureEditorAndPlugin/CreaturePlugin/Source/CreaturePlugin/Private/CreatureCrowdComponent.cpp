@@ -0,0 +1,327 @@
+
+#include "CreaturePluginPCH.h"
+#include "CreatureCrowdComponent.h"
+#include "CreatureMeshComponent.h"
+#include <Runtime/Core/Public/Async/ParallelFor.h>
+
+DECLARE_CYCLE_STAT(TEXT("CreatureCrowd_Gather"), STAT_CreatureCrowd_Gather, STATGROUP_Creature);
+DECLARE_CYCLE_STAT(TEXT("CreatureCrowd_RebuildLayout"), STAT_CreatureCrowd_RebuildLayout, STATGROUP_Creature);
+
+UCreatureCrowdComponent::UCreatureCrowdComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	// Gathers after all creatures, including the ones running their update on a task, are done for the frame
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = true;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+
+	crowd_lock = TSharedPtr<FCriticalSection, ESPMode::ThreadSafe>(new FCriticalSection());
+	layout_dirty = false;
+}
+
+void UCreatureCrowdComponent::AddCreature(UCreatureMeshComponent * creature_in)
+{
+	if ((creature_in == nullptr) || (creature_in->crowd_owner == this))
+	{
+		return;
+	}
+
+	if (creature_in->enable_collection_playback)
+	{
+		// Collections switch between several characters, the crowd batch only draws a single one per creature
+		UE_LOG(LogTemp, Warning, TEXT("UCreatureCrowdComponent::AddCreature() - %s uses collection playback and can not be drawn by a crowd"), *creature_in->GetName());
+		return;
+	}
+
+	if (creature_in->crowd_owner)
+	{
+		creature_in->crowd_owner->RemoveCreature(creature_in);
+	}
+
+	crowd_creatures.Add(creature_in);
+	creature_in->crowd_owner = this;
+	creature_in->MarkRenderStateDirty();
+	layout_dirty = true;
+}
+
+void UCreatureCrowdComponent::RemoveCreature(UCreatureMeshComponent * creature_in)
+{
+	if ((creature_in == nullptr) || (crowd_creatures.Remove(creature_in) == 0))
+	{
+		return;
+	}
+
+	creature_in->crowd_owner = nullptr;
+	creature_in->MarkRenderStateDirty();
+	layout_dirty = true;
+}
+
+int32 UCreatureCrowdComponent::GetCreatureCount() const
+{
+	return crowd_creatures.Num();
+}
+
+void UCreatureCrowdComponent::OnUnregister()
+{
+	for (auto cur_creature : crowd_creatures)
+	{
+		if (cur_creature && (cur_creature->crowd_owner == this))
+		{
+			cur_creature->crowd_owner = nullptr;
+			cur_creature->MarkRenderStateDirty();
+		}
+	}
+
+	crowd_creatures.Empty();
+	crowd_slots.Empty();
+
+	Super::OnUnregister();
+}
+
+bool UCreatureCrowdComponent::IsCreatureReady(UCreatureMeshComponent * creature_in) const
+{
+	if ((creature_in == nullptr) || creature_in->IsPendingKill() || (creature_in->crowd_owner != this)
+		|| creature_in->enable_collection_playback)
+	{
+		return false;
+	}
+
+	CreatureCore& cur_core = creature_in->GetCore();
+	if ((cur_core.GetCreatureManager() == nullptr) || (cur_core.global_indices_copy == nullptr))
+	{
+		return false;
+	}
+
+	return cur_core.region_alphas.Num() == cur_core.GetCreatureManager()->GetCreature()->GetTotalNumPoints();
+}
+
+bool UCreatureCrowdComponent::HasLayoutChanged() const
+{
+	int32 slot_idx = 0;
+	for (auto cur_creature : crowd_creatures)
+	{
+		if (!IsCreatureReady(cur_creature))
+		{
+			continue;
+		}
+
+		if (!crowd_slots.IsValidIndex(slot_idx))
+		{
+			return true;
+		}
+
+		auto cur_creature_data = cur_creature->GetCore().GetCreatureManager()->GetCreature();
+		const FCreatureCrowdSlot& cur_slot = crowd_slots[slot_idx];
+		if ((cur_slot.point_num != cur_creature_data->GetTotalNumPoints())
+			|| (cur_slot.indices_num != cur_creature_data->GetTotalNumIndices()))
+		{
+			return true;
+		}
+
+		slot_idx++;
+	}
+
+	return slot_idx != crowd_slots.Num();
+}
+
+void UCreatureCrowdComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	// Destroyed creatures or creatures moved into another crowd drop out
+	for (int32 i = crowd_creatures.Num() - 1; i >= 0; i--)
+	{
+		auto cur_creature = crowd_creatures[i];
+		if ((cur_creature == nullptr) || cur_creature->IsPendingKill() || (cur_creature->crowd_owner != this))
+		{
+			crowd_creatures.RemoveAt(i);
+			layout_dirty = true;
+		}
+	}
+
+	if (layout_dirty || HasLayoutChanged())
+	{
+		RebuildLayout();
+		return;
+	}
+
+	if (crowd_slots.Num() == 0)
+	{
+		return;
+	}
+
+	GatherCreatures(false);
+
+	FCProceduralMeshSceneProxy *localRenderProxy = GetLocalRenderProxy();
+	if (localRenderProxy)
+	{
+		// Region ordering can change the indices of any creature, unchanged indices are not uploaded again
+		localRenderProxy->SetNeedsIndexUpdate(true);
+	}
+
+	ForceAnUpdate();
+}
+
+void UCreatureCrowdComponent::RebuildLayout()
+{
+	SCOPE_CYCLE_COUNTER(STAT_CreatureCrowd_RebuildLayout);
+
+	layout_dirty = false;
+
+	// The old proxy reads the crowd buffers on the render thread, retire it before they get resized
+	const bool had_render_state = bRenderStateCreated;
+	if (had_render_state)
+	{
+		DestroyRenderState_Concurrent();
+		FlushRenderingCommands();
+	}
+
+	crowd_slots.Reset();
+	int32 total_points = 0, total_indices = 0;
+	for (auto cur_creature : crowd_creatures)
+	{
+		if (!IsCreatureReady(cur_creature))
+		{
+			continue;
+		}
+
+		auto cur_creature_data = cur_creature->GetCore().GetCreatureManager()->GetCreature();
+		FCreatureCrowdSlot new_slot;
+		new_slot.point_offset = total_points;
+		new_slot.point_num = cur_creature_data->GetTotalNumPoints();
+		new_slot.indice_offset = total_indices;
+		new_slot.indices_num = cur_creature_data->GetTotalNumIndices();
+		crowd_slots.Add(new_slot);
+
+		total_points += new_slot.point_num;
+		total_indices += new_slot.indices_num;
+	}
+
+	{
+		FScopeLock scope_lock(crowd_lock.Get());
+		crowd_indices.SetNumUninitialized(total_indices);
+		crowd_uvs.SetNumUninitialized(total_points * 2);
+		crowd_alphas.SetNumUninitialized(total_points);
+	}
+
+	if (crowd_slots.Num() > 0)
+	{
+		GatherCreatures(true);
+		SetProceduralMeshTriData(FProceduralMeshTriData(crowd_indices.GetData(),
+			nullptr, crowd_uvs.GetData(),
+			total_points, total_indices,
+			&crowd_alphas,
+			crowd_lock,
+			&crowd_points));
+	}
+	else {
+		static FProceduralMeshTriData empty_data;
+		SetProceduralMeshTriData(empty_data);
+	}
+
+	if (had_render_state)
+	{
+		CreateRenderState_Concurrent();
+	}
+}
+
+void UCreatureCrowdComponent::GatherCreatures(bool force_attributes)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CreatureCrowd_Gather);
+
+	FScopeLock scope_lock(crowd_lock.Get());
+
+	TArray<UCreatureMeshComponent *> slot_creatures;
+	slot_creatures.Reserve(crowd_slots.Num());
+	bool update_attributes = force_attributes;
+	for (auto cur_creature : crowd_creatures)
+	{
+		if (IsCreatureReady(cur_creature))
+		{
+			slot_creatures.Add(cur_creature);
+			update_attributes = update_attributes || cur_creature->GetCore().should_update_render_attributes;
+		}
+	}
+
+	check(slot_creatures.Num() == crowd_slots.Num());
+
+	TArray<FVector>& write_pts = crowd_points.GetWriteBuffer();
+	write_pts.SetNumUninitialized(crowd_alphas.Num());
+	const FTransform crowd_xform = GetComponentTransform();
+
+	// Every creature writes into its own slot of the crowd buffers
+#ifdef CREATURE_MULTICORE
+	ParallelFor(crowd_slots.Num(), [&](int32 slot_idx) {
+#else
+	for (int32 slot_idx = 0; slot_idx < crowd_slots.Num(); slot_idx++) {
+#endif
+		UCreatureMeshComponent * cur_creature = slot_creatures[slot_idx];
+		const FCreatureCrowdSlot& cur_slot = crowd_slots[slot_idx];
+		CreatureCore& cur_core = cur_creature->GetCore();
+
+		FScopeLock core_lock(cur_core.update_lock.Get());
+		auto cur_creature_data = cur_core.GetCreatureManager()->GetCreature();
+
+		// Positions, moved from the creature's space into the crowd's space
+		const FMatrix to_crowd_xform = cur_creature->GetComponentTransform().GetRelativeTransform(crowd_xform).ToMatrixWithScale();
+		FVector * dst_pts = write_pts.GetData() + cur_slot.point_offset;
+		const bool use_staging = cur_core.skin_into_render_staging && cur_core.render_staging_frames.IsValid()
+			&& (cur_core.render_staging_frames->GetLastPublished().Num() == cur_slot.point_num);
+		if (use_staging)
+		{
+			const TArray<FVector>& staging_pts = cur_core.render_staging_frames->GetLastPublished();
+			for (int32 i = 0; i < cur_slot.point_num; i++)
+			{
+				dst_pts[i] = to_crowd_xform.TransformPosition(staging_pts[i]);
+			}
+		}
+		else {
+			const glm::float32 * src_pts = cur_creature_data->GetRenderPts();
+			for (int32 i = 0; i < cur_slot.point_num; i++)
+			{
+				const glm::float32 * read_pt = src_pts + (i * 3);
+				dst_pts[i] = to_crowd_xform.TransformPosition(FVector(read_pt[0], read_pt[2], read_pt[1]));
+			}
+		}
+
+		// Indices, hidden creatures and unused skin swap indices are collapsed into degenerate triangles
+		glm::uint32 * dst_indices = crowd_indices.GetData() + cur_slot.indice_offset;
+		int32 draw_indices_num = cur_creature->ShouldSkipTick() ? 0 : cur_slot.indices_num;
+		if ((draw_indices_num > 0) && cur_core.shouldSkinSwap())
+		{
+			draw_indices_num = FMath::Min(cur_core.GetRealTotalIndicesNum(), cur_slot.indices_num);
+		}
+
+		const glm::uint32 * src_indices = cur_core.global_indices_copy;
+		for (int32 i = 0; i < draw_indices_num; i++)
+		{
+			dst_indices[i] = src_indices[i] + cur_slot.point_offset;
+		}
+
+		for (int32 i = draw_indices_num; i < cur_slot.indices_num; i++)
+		{
+			dst_indices[i] = cur_slot.point_offset;
+		}
+
+		if (update_attributes)
+		{
+			FMemory::Memcpy(crowd_uvs.GetData() + (cur_slot.point_offset * 2),
+				cur_creature_data->GetGlobalUvs(),
+				cur_slot.point_num * 2 * sizeof(glm::float32));
+			FMemory::Memcpy(crowd_alphas.GetData() + cur_slot.point_offset,
+				cur_core.region_alphas.GetData(),
+				cur_slot.point_num * sizeof(uint8));
+		}
+#ifdef CREATURE_MULTICORE
+	});
+#else
+	}
+#endif
+
+	crowd_points.Publish();
+
+	if (update_attributes)
+	{
+		MarkAttributesDirty();
+	}
+}
@@ -2,6 +2,7 @@
 #include "CreaturePluginPCH.h"
 #include "CreatureMeshComponent.h"
 #include "CreatureAnimStateMachine.h"
+#include "CreatureUpdateScheduler.h"
 //////////////////////////////////////////////////////////////////////////
 //Changed by god of pen
 //////////////////////////////////////////////////////////////////////////
@@ -24,7 +25,6 @@
 
 
 DECLARE_CYCLE_STAT(TEXT("CreatureMesh_Tick"), STAT_CreatureMesh_Tick, STATGROUP_Creature);
-DECLARE_CYCLE_STAT(TEXT("CreatureMesh_AsyncTick"), STAT_CreatureMesh_Tick_Async, STATGROUP_Creature);
 DECLARE_CYCLE_STAT(TEXT("CreatureMesh_UpdateCoreValues"), STAT_CreatureMesh_UpdateCoreValues, STATGROUP_Creature);
 DECLARE_CYCLE_STAT(TEXT("CreatureMesh_MeshUpdate"), STAT_CreatureMesh_MeshUpdate, STATGROUP_Creature);
 DECLARE_CYCLE_STAT(TEXT("CreatureMesh_ProcessCreatureCoreResults"), STAT_CreatureMesh_ProcessCreatureCoreResults, STATGROUP_Creature);
@@ -35,18 +35,12 @@ UCreatureMeshComponent::UCreatureMeshComponent(const FObjectInitializer& ObjectI
 {
 	PrimaryComponentTick.bCanEverTick = true;
 
-	EndPhysicsTickFunction.TickGroup = TG_PostPhysics;
-	EndPhysicsTickFunction.bCanEverTick = true;
-	EndPhysicsTickFunction.bStartWithTickEnabled = true;
-	EndPhysicsTickFunction.bTickEvenWhenPaused = false;
-
 	InitStandardValues();
 }
 
 void UCreatureMeshComponent::SetBluePrintAlwaysTick(bool flag_in)
 {
 	PrimaryComponentTick.bTickEvenWhenPaused = flag_in;
-	EndPhysicsTickFunction.bTickEvenWhenPaused = flag_in;
 }
 
 void UCreatureMeshComponent::SetBluePrintActiveAnimation(FString name_in)
@@ -152,6 +146,16 @@ FTransform UCreatureMeshComponent::GetBluePrintBoneXform_Name(FName name_in, boo
 	return creature_core.GetBluePrintBoneXform(name_in, world_transform, position_slide_factor, GetComponentToWorld());
 }
 
+int32 UCreatureMeshComponent::GetBluePrintBoneIndex(FName name_in) const
+{
+	return creature_core.GetBoneDataIndex(name_in);
+}
+
+FTransform UCreatureMeshComponent::GetBluePrintBoneXform_Index(int32 bone_index, bool world_transform, float position_slide_factor) const
+{
+	return creature_core.GetBoneXform(bone_index, world_transform, position_slide_factor, GetComponentToWorld());
+}
+
 void UCreatureMeshComponent::SetBluePrintAnimationLoop(bool flag_in)
 {
 	creature_core.SetBluePrintAnimationLoop(flag_in);
@@ -237,9 +241,10 @@ void UCreatureMeshComponent::RemoveBluePrintRegionAlpha_Name(FName region_name_i
 	creature_core.RemoveBluePrintRegionAlpha(region_name_in);
 }
 
-void UCreatureMeshComponent::SetBluePrintRegionCustomOrder(TArray<FString> order_in)
+void UCreatureMeshComponent::SetBluePrintRegionCustomOrder(const TArray<FString>& order_in)
 {
 	TArray<FName> order_name;
+	order_name.Reserve(order_in.Num());
 	for (const FString &str : order_in)
 	{
 		order_name.Add(FName(*str));
@@ -247,7 +252,7 @@ void UCreatureMeshComponent::SetBluePrintRegionCustomOrder(TArray<FString> order
 	creature_core.SetBluePrintRegionCustomOrder(order_name);
 }
 
-void UCreatureMeshComponent::SetBluePrintRegionCustomOrder_Name(TArray<FName> order_in)
+void UCreatureMeshComponent::SetBluePrintRegionCustomOrder_Name(const TArray<FName>& order_in)
 {
 	creature_core.SetBluePrintRegionCustomOrder(order_in);
 }
@@ -463,6 +468,10 @@ void UCreatureMeshComponent::InitStandardValues()
 	region_overlap_z_delta = 0.01f;
 	enable_collection_playback = false;
 	active_collection_clip = nullptr;
+	callback_timelines_dirty = true;
+	active_callback_timeline = nullptr;
+	next_frame_callback = 0;
+	last_callback_frame = INDEX_NONE;
 	active_collection_loop = true;
 	active_collection_play = true;
 	creature_animation_asset = nullptr;
@@ -472,6 +481,21 @@ void UCreatureMeshComponent::InitStandardValues()
 	completely_disable = false;
 	fixed_timestep = 0.0f;
 	run_task_multicore = false;
+	skin_into_render_buffer = false;
+	bounds_mode = ECreatureBoundsMode::Posed;
+	enable_update_rate_optimizations = false;
+	uro_offscreen_frames = 3;
+	uro_small_screen_size = 0.1f;
+	uro_small_update_rate = 4;
+	budget_priority = 1.0f;
+	budget_max_skip_frames = 8;
+	share_poses = false;
+	shared_pose_time_step = 0.25f;
+	uro_last_render_time = -1.0f;
+	uro_frames_not_rendered = 0;
+	uro_frames_since_update = 0;
+	active_lod_level = INDEX_NONE;
+	crowd_owner = nullptr;
 	use_anchor_points = false;
 
 	// Generate a single dummy triangle
@@ -501,6 +525,10 @@ void UCreatureMeshComponent::UpdateCoreValues()
 	creature_core.bone_data_size = bone_data_size;
 	creature_core.bone_data_length_factor = bone_data_length_factor;
 	creature_core.region_overlap_z_delta = region_overlap_z_delta;
+	creature_core.skin_into_render_staging = skin_into_render_buffer;
+	creature_core.use_clip_bounds = (bounds_mode == ECreatureBoundsMode::Clip);
+	creature_core.use_shared_pose_cache = share_poses;
+	creature_core.shared_pose_time_step = FMath::Max(shared_pose_time_step, 0.0f);
 }
 
 void UCreatureMeshComponent::PrepareRenderData(CreatureCore &forCore)
@@ -532,36 +560,24 @@ void UCreatureMeshComponent::RunTick(float DeltaTime)
 		return;
 	}
 
-	// Frame Callback events, if any
-	if ((GetWorld()->WorldType != EWorldType::Type::Editor) &&
-		(GetWorld()->WorldType != EWorldType::Type::EditorPreview))
-	{
-		if (CreatureFrameCallbackEvent.IsBound() || CreatureRepeatFrameCallbackEvent.IsBound()) {
-			const auto& cur_animation_name = creature_core.GetCreatureManager()->GetActiveAnimationName();
-			auto cur_animation = creature_core.GetCreatureManager()->GetAnimation(cur_animation_name);
-			auto diff_runtime = fabs(creature_core.GetCreatureManager()->getActualRunTime() - cur_animation->getStartTime());
-			const auto small_num = 0.0001f;
-			if (diff_runtime <= small_num)
-			{
-				ResetFrameCallbacks();
-			}
-
-			ProcessFrameCallbacks();
-		}
-	}
+	RunFrameCallbacks();
 
 	// Run the animation
 	if (run_task_multicore) {
 		// Make sure this only runs for characters that will not be removed from the scene
 		// otherwise it might not be safe
-		creatureTickResult = Async<bool>(EAsyncExecution::TaskGraph, [this, DeltaTime]()
-		{
-			SCOPE_CYCLE_COUNTER(STAT_CreatureMesh_Tick_Async);
-			return RunTickProcessing(DeltaTime, false);
-		});
+		FCreatureUpdateScheduler::Get(GetWorld())->QueueUpdate(this, DeltaTime);
 	}
 	else {
+		const double start_time = FPlatformTime::Seconds();
 		auto can_tick = RunTickProcessing(DeltaTime, true);
+
+		// Costs only matter to the budget, which made the scheduler when this component asked for its update
+		FCreatureUpdateScheduler * cur_scheduler = FCreatureUpdateScheduler::IsBudgetEnabled() ? FCreatureUpdateScheduler::Find(GetWorld()) : nullptr;
+		if (cur_scheduler)
+		{
+			cur_scheduler->RecordUpdateCost(this, (FPlatformTime::Seconds() - start_time) * 1000.0);
+		}
 		if (can_tick) {
 			// fire events
 			FireStartEndEvents();
@@ -569,6 +585,174 @@ void UCreatureMeshComponent::RunTick(float DeltaTime)
 	}
 }
 
+void UCreatureMeshComponent::RunClockTick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CreatureMesh_Tick);
+
+	UpdateCoreValues();
+
+	if (bHiddenInGame)
+	{
+		return;
+	}
+
+	RunFrameCallbacks();
+
+	if (creature_core.RunClockTick(DeltaTime))
+	{
+		animation_frame = creature_core.GetCreatureManager()->getActualRunTime();
+		if (bounds_mode == ECreatureBoundsMode::Baked)
+		{
+			UpdateBakedBounds();
+		}
+
+		FireStartEndEvents();
+	}
+}
+
+void UCreatureMeshComponent::RunFrameCallbacks()
+{
+	// Frame Callback events, if any
+	if ((GetWorld()->WorldType != EWorldType::Type::Editor) &&
+		(GetWorld()->WorldType != EWorldType::Type::EditorPreview))
+	{
+		if (CreatureFrameCallbackEvent.IsBound() || CreatureRepeatFrameCallbackEvent.IsBound()) {
+			ProcessFrameCallbacks();
+		}
+	}
+}
+
+bool UCreatureMeshComponent::ShouldRunFullUpdate()
+{
+	// Crowd members are drawn by their crowd, so their own render time never moves
+	if (!enable_update_rate_optimizations || crowd_owner)
+	{
+		return RequestBudgetedUpdate();
+	}
+
+	if (LastRenderTimeOnScreen != uro_last_render_time)
+	{
+		uro_last_render_time = LastRenderTimeOnScreen;
+		uro_frames_not_rendered = 0;
+	}
+	else {
+		uro_frames_not_rendered++;
+	}
+
+	if (uro_frames_not_rendered > uro_offscreen_frames)
+	{
+		// Pose right away once the character shows up again
+		uro_frames_since_update = MAX_int32 - 1;
+		return false;
+	}
+
+	int32 update_rate = 1;
+	if (GetScreenSize() < uro_small_screen_size)
+	{
+		update_rate = FMath::Max(uro_small_update_rate, 1);
+	}
+
+	uro_frames_since_update++;
+	if (uro_frames_since_update < update_rate)
+	{
+		return false;
+	}
+
+	// Past the update rate, the frame budget has the final say. Turned down characters try again next tick.
+	if (!RequestBudgetedUpdate())
+	{
+		return false;
+	}
+
+	uro_frames_since_update = 0;
+	return true;
+}
+
+bool UCreatureMeshComponent::RequestBudgetedUpdate()
+{
+	if (!FCreatureUpdateScheduler::IsBudgetEnabled())
+	{
+		return true;
+	}
+
+	return FCreatureUpdateScheduler::Get(GetWorld())->RequestFullUpdate(this, GetScreenSize() * budget_priority, budget_max_skip_frames);
+}
+
+void UCreatureMeshComponent::UpdateLodLevel(float screen_size)
+{
+	active_lod_level = INDEX_NONE;
+	for (int32 i = 0; i < lod_levels.Num(); i++)
+	{
+		if ((screen_size < lod_levels[i].screen_size)
+			&& ((active_lod_level == INDEX_NONE) || (lod_levels[i].screen_size < lod_levels[active_lod_level].screen_size)))
+		{
+			active_lod_level = i;
+		}
+	}
+
+	CreatureModule::CreatureLodSettings new_settings;
+	if (active_lod_level != INDEX_NONE)
+	{
+		const FCreatureLodLevel& cur_level = lod_levels[active_lod_level];
+		new_settings.max_bone_influences = cur_level.max_bone_influences;
+		new_settings.bone_sample_step = FMath::Max(cur_level.bone_sample_frames, 1);
+		new_settings.skip_displacements = cur_level.skip_displacements;
+		new_settings.skip_uv_warps = cur_level.skip_uv_warps;
+	}
+
+	creature_core.lod_settings = new_settings;
+}
+
+float UCreatureMeshComponent::GetScreenSize() const
+{
+	float max_screen_size = 0.0f;
+	bool has_camera = false;
+	for (FConstPlayerControllerIterator it = GetWorld()->GetPlayerControllerIterator(); it; ++it)
+	{
+		APlayerController * cur_controller = it->Get();
+		if ((cur_controller == nullptr) || (cur_controller->PlayerCameraManager == nullptr))
+		{
+			continue;
+		}
+
+		const FMinimalViewInfo& cur_view = cur_controller->PlayerCameraManager->GetCameraCachePOV();
+		float view_extent = 0.0f;
+		if (cur_view.ProjectionMode == ECameraProjectionMode::Orthographic)
+		{
+			view_extent = cur_view.OrthoWidth * 0.5f;
+		}
+		else {
+			float cur_dist = FVector::Dist(Bounds.Origin, cur_view.Location);
+			view_extent = cur_dist * FMath::Tan(FMath::DegreesToRadians(cur_view.FOV * 0.5f));
+		}
+
+		has_camera = true;
+		max_screen_size = FMath::Max(max_screen_size, Bounds.SphereRadius / FMath::Max(view_extent, 1.0f));
+	}
+
+	return has_camera ? max_screen_size : 1.0f;
+}
+
+void UCreatureMeshComponent::UpdateBakedBounds()
+{
+	FBox baked_bounds = creature_core.GetBakedRenderBounds();
+	if (!baked_bounds.IsValid)
+	{
+		return;
+	}
+
+	FScopeLock cur_lock(&local_lock);
+
+	FCProceduralMeshSceneProxy *localRenderProxy = GetLocalRenderProxy();
+	if (render_proxy_ready && localRenderProxy)
+	{
+		SetBoundsScale(creature_bounds_scale);
+		SetPoseBounds(baked_bounds);
+		ProcessCalcBounds(localRenderProxy);
+		MarkRenderTransformDirty();
+	}
+}
+
 bool UCreatureMeshComponent::RunTickProcessing(float DeltaTime, bool markDirty)
 {
 	// Run the animation
@@ -579,23 +763,25 @@ bool UCreatureMeshComponent::RunTickProcessing(float DeltaTime, bool markDirty)
 		FScopeLock cur_lock(&local_lock);
 
 		animation_frame = creature_core.GetCreatureManager()->getActualRunTime();
-		DoCreatureMeshUpdate(INDEX_NONE, markDirty);		
+		if (!creature_core.pose_unchanged)
+		{
+			DoCreatureMeshUpdate(INDEX_NONE, markDirty);
+		}
+
 		TryCreateBendPhysics();
 	}
 
 	return can_tick;
 }
 
-void UCreatureMeshComponent::ProcessCreatureCoreResult(FCreatureCoreResultTickFunction& ThisTickFunction)
+void UCreatureMeshComponent::ProcessCreatureCoreResult(bool can_tick)
 {
-	if (ShouldSkipTick() || (!run_task_multicore))
+	if (ShouldSkipTick())
 	{
 		return;
 	}
 
 	SCOPE_CYCLE_COUNTER(STAT_CreatureMesh_ProcessCreatureCoreResults);
-	
-	bool can_tick = creatureTickResult.IsValid() && creatureTickResult.Get();
 
 	if (can_tick)
 	{
@@ -608,7 +794,7 @@ void UCreatureMeshComponent::ProcessCreatureCoreResult(FCreatureCoreResultTickFu
 			MarkRenderStateDirty();
 			recreate_render_proxy = false;
 		}
-		else
+		else if (!creature_core.pose_unchanged)
 		{
 			FCProceduralMeshSceneProxy *localRenderProxy = GetLocalRenderProxy();
 			if (render_proxy_ready && localRenderProxy)
@@ -770,6 +956,11 @@ UCreatureMeshComponent::RunCollectionTick(float DeltaTime)
 			}
 		}
 
+		if (cur_core.should_update_render_attributes)
+		{
+			MarkAttributesDirty();
+		}
+
 		DoCreatureMeshUpdate(GetCollectionDataIndexFromClip(active_collection_clip));
 	}
 }
@@ -787,9 +978,24 @@ void UCreatureMeshComponent::DoCreatureMeshUpdate(int render_packet_idx, bool ma
 		localRenderProxy->SetNeedsIndexUpdate(creature_core.should_update_render_indices, draw_indices_num);
 	}
 
+	if (creature_core.should_update_render_attributes)
+	{
+		MarkAttributesDirty();
+	}
+
 	// Update Mesh
 	SetBoundsScale(creature_bounds_scale);
 	SetBoundsOffset(creature_bounds_offset);
+	if ((bounds_mode != ECreatureBoundsMode::Scan) && !enable_collection_playback)
+	{
+		FBox new_bounds(ForceInit);
+		if (bounds_mode == ECreatureBoundsMode::Baked)
+		{
+			new_bounds = creature_core.GetBakedRenderBounds();
+		}
+
+		SetPoseBounds(new_bounds.IsValid ? new_bounds : creature_core.GetRenderBounds());
+	}
 
 	ForceAnUpdate(render_packet_idx, markDirty);
 
@@ -876,8 +1082,6 @@ void UCreatureMeshComponent::TickComponent(float DeltaTime, enum ELevelTick Tick
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 	bool shouldSkipTick = ShouldSkipTick();
-	
-	RegisterCoreResultsTickFunction(!shouldSkipTick && !enable_collection_playback);
 
 	if (shouldSkipTick)
 	{
@@ -889,7 +1093,7 @@ void UCreatureMeshComponent::TickComponent(float DeltaTime, enum ELevelTick Tick
 	//////////////////////////////////////////////////////////////////////////
 	if (StateMachineInstance !=nullptr)
 	{
-		StateMachineInstance->GetCurrentState()->CheckCondition(StateMachineInstance);
+		StateMachineInstance->EvaluatePendingTransitions();
 	}
 	
 	if (enable_collection_playback)
@@ -905,25 +1109,26 @@ void UCreatureMeshComponent::TickComponent(float DeltaTime, enum ELevelTick Tick
 				real_delta_time = fixed_timestep;
 			}
 			
-			RunTick(real_delta_time);
+			if (ShouldRunFullUpdate())
+			{
+				if (lod_levels.Num() > 0)
+				{
+					UpdateLodLevel(GetScreenSize());
+				}
+				else if (active_lod_level != INDEX_NONE)
+				{
+					UpdateLodLevel(1.0f);
+				}
+
+				RunTick(real_delta_time);
+			}
+			else {
+				RunClockTick(real_delta_time);
+			}
 		}
 	}
 }
 
-void FCreatureCoreResultTickFunction::ExecuteTick(float DeltaTime, enum ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
-{
-	QUICK_SCOPE_CYCLE_COUNTER(FCreatureCoreResultTickFunction_ExecuteTick);
-	FActorComponentTickFunction::ExecuteTickHelper(Target, /*bTickInEditor=*/ false, DeltaTime, TickType, [this](float DilatedTime)
-	{
-		Target->ProcessCreatureCoreResult(*this);
-	});
-}
-
-FString FCreatureCoreResultTickFunction::DiagnosticMessage()
-{
-	return TEXT("FCreatureMeshComponentEndPhysicsTickFunction");
-}
-
 void UCreatureMeshComponent::OnRegister()
 {
 	Super::OnRegister();
@@ -938,29 +1143,16 @@ void UCreatureMeshComponent::OnRegister()
 	}
 }
 
-void UCreatureMeshComponent::RegisterComponentTickFunctions(bool bRegister)
+void UCreatureMeshComponent::OnUnregister()
 {
-	Super::RegisterComponentTickFunctions(bRegister);
-
-	RegisterCoreResultsTickFunction(bRegister && !enable_collection_playback);
-}
-
-void UCreatureMeshComponent::RegisterCoreResultsTickFunction(bool bRegister)
-{
-	if (bRegister != EndPhysicsTickFunction.IsTickFunctionRegistered())
+	// A queued update must not run on a worker after the component is gone
+	FCreatureUpdateScheduler * cur_scheduler = FCreatureUpdateScheduler::Find(GetWorld());
+	if (cur_scheduler)
 	{
-		if (bRegister)
-		{
-			if (SetupActorComponentTickFunction(&EndPhysicsTickFunction))
-			{
-				EndPhysicsTickFunction.Target = this;
-			}
-		}
-		else
-		{
-			EndPhysicsTickFunction.UnRegisterTickFunction();
-		}
+		cur_scheduler->RemoveComponent(this);
 	}
+
+	Super::OnUnregister();
 }
 
 void UCreatureMeshComponent::StandardInit()
@@ -1075,6 +1267,12 @@ void UCreatureMeshComponent::CollectionInit()
 
 FPrimitiveSceneProxy* UCreatureMeshComponent::CreateSceneProxy()
 {
+	// Drawn by the crowd instead, the crowd leaves out collection playback
+	if (crowd_owner && !enable_collection_playback)
+	{
+		return nullptr;
+	}
+
 	if (enable_collection_playback == false)
 	{
 		return UCustomProceduralMeshComponent::CreateSceneProxy();
@@ -1302,11 +1500,13 @@ UCreatureMeshComponent::RemoveBluePrintBonesIKConstraint(FCreatureBoneIK ik_data
 void UCreatureMeshComponent::SetBluePrintFrameCallbacks(const TArray<FCreatureFrameCallback>& callbacks_in)
 {
 	frame_callbacks = callbacks_in;
+	callback_timelines_dirty = true;
 }
 
 void UCreatureMeshComponent::ClearBluePrintFrameCallbacks()
 {
 	frame_callbacks.Empty();
+	callback_timelines_dirty = true;
 }
 
 void 
@@ -1337,11 +1537,13 @@ UCreatureMeshComponent::LoadBlueprintFramCallBacksAsset()
 void UCreatureMeshComponent::SetBluePrintRepeatFrameCallbacks(const TArray<FCreatureRepeatFrameCallback>& callbacks_in)
 {
 	repeat_frame_callbacks = callbacks_in;
+	callback_timelines_dirty = true;
 }
 
 void UCreatureMeshComponent::ClearBluePrintRepeatFrameCallbacks()
 {
 	repeat_frame_callbacks.Empty();
+	callback_timelines_dirty = true;
 }
 
 FName
@@ -1728,30 +1930,123 @@ void UCreatureMeshComponent::ResetFrameCallbacks()
 	{
 		frame_callback.resetCallback(creature_core.creature_manager->getRunTime());
 	}
+
+	next_frame_callback = 0;
+	last_callback_frame = INDEX_NONE;
+}
+
+void UCreatureMeshComponent::BuildCallbackTimelines()
+{
+	callback_timelines.Reset();
+	for (int32 i = 0; i < frame_callbacks.Num(); i++)
+	{
+		callback_timelines.FindOrAdd(frame_callbacks[i].animClipName).frame_callback_ids.Add(i);
+	}
+
+	for (int32 i = 0; i < repeat_frame_callbacks.Num(); i++)
+	{
+		callback_timelines.FindOrAdd(repeat_frame_callbacks[i].animClipName).repeat_callback_ids.Add(i);
+	}
+
+	for (auto& cur_timeline : callback_timelines)
+	{
+		cur_timeline.Value.frame_callback_ids.StableSort([this](int32 a, int32 b) {
+			return frame_callbacks[a].frame < frame_callbacks[b].frame;
+		});
+	}
+
+	callback_timelines_dirty = false;
+
+	// The timeline of the active clip is looked up again, starting from its first callback
+	callback_timeline_clip = NAME_None;
+	active_callback_timeline = nullptr;
 }
 
 void UCreatureMeshComponent::ProcessFrameCallbacks()
 {
-	auto cur_runtime = creature_core.creature_manager->getActualRunTime();
-	for (auto& frame_callback : frame_callbacks)
+	if (callback_timelines_dirty)
 	{
-		if (frame_callback.animClipName == creature_core.creature_manager->GetActiveAnimationName()) {
-			auto should_trigger = frame_callback.tryTrigger(cur_runtime);
-			if (should_trigger && CreatureFrameCallbackEvent.IsBound())
+		BuildCallbackTimelines();
+	}
+
+	auto cur_runtime = creature_core.creature_manager->getActualRunTime();
+	const int32 cur_frame = (int32)roundf(cur_runtime);
+	const FName& cur_animation_name = creature_core.creature_manager->GetActiveAnimationName();
+	if ((cur_animation_name != callback_timeline_clip) || (active_callback_timeline == nullptr))
+	{
+		callback_timeline_clip = cur_animation_name;
+		active_callback_timeline = callback_timelines.Find(cur_animation_name);
+		ResetFrameCallbacks();
+	}
+	else if (cur_frame < last_callback_frame)
+	{
+		// Looped back or jumped to an earlier frame, the callbacks of the clip can trigger again.
+		// Playing forward this means the clip wrapped, so what was left up to the clip end triggers first
+		// and the clip then starts over from its start frame, catching up to the current frame below.
+		auto cur_clip = creature_core.creature_manager->GetAnimation(cur_animation_name);
+		const bool is_wrap = active_callback_timeline && cur_clip && (creature_core.creature_manager->GetTimeScale() >= 0.0f);
+		if (is_wrap)
+		{
+			TriggerFrameCallbacks(cur_clip->getEndTime());
+		}
+
+		ResetFrameCallbacks();
+
+		if (is_wrap && !callback_timelines_dirty)
+		{
+			for (int32 repeat_id : active_callback_timeline->repeat_callback_ids)
 			{
-				CreatureFrameCallbackEvent.Broadcast(frame_callback.name);
+				repeat_frame_callbacks[repeat_id].resetCallback(cur_clip->getStartTime());
 			}
 		}
 	}
 
-	for (auto& frame_callback : repeat_frame_callbacks)
+	last_callback_frame = cur_frame;
+
+	if (active_callback_timeline == nullptr)
 	{
-		if (frame_callback.animClipName == creature_core.creature_manager->GetActiveAnimationName()) {
-			auto should_trigger = frame_callback.tryTrigger(cur_runtime);
-			if (should_trigger && CreatureRepeatFrameCallbackEvent.IsBound())
-			{
-				CreatureRepeatFrameCallbackEvent.Broadcast(frame_callback.name);
-			}
+		return;
+	}
+
+	TriggerFrameCallbacks(cur_runtime);
+}
+
+void UCreatureMeshComponent::TriggerFrameCallbacks(float frame_in)
+{
+	// A handler that changes the callbacks or resets them ends the pass, its indices are no longer valid
+	auto callbacks_changed = [this]() {
+		return callback_timelines_dirty || (last_callback_frame == INDEX_NONE);
+	};
+
+	// Callbacks are sorted by frame, so everything up to the frame triggers in order however far this tick jumped
+	const TArray<int32>& frame_ids = active_callback_timeline->frame_callback_ids;
+	while ((next_frame_callback < frame_ids.Num()) && !callbacks_changed())
+	{
+		auto& frame_callback = frame_callbacks[frame_ids[next_frame_callback]];
+		if (!frame_callback.tryTrigger(frame_in))
+		{
+			break;
+		}
+
+		next_frame_callback++;
+		if (CreatureFrameCallbackEvent.IsBound())
+		{
+			CreatureFrameCallbackEvent.Broadcast(frame_callback.name);
+		}
+	}
+
+	for (int32 repeat_id : active_callback_timeline->repeat_callback_ids)
+	{
+		if (callbacks_changed())
+		{
+			break;
+		}
+
+		auto& frame_callback = repeat_frame_callbacks[repeat_id];
+		auto should_trigger = frame_callback.tryTrigger(frame_in);
+		if (should_trigger && CreatureRepeatFrameCallbackEvent.IsBound())
+		{
+			CreatureRepeatFrameCallbackEvent.Broadcast(frame_callback.name);
 		}
 	}
 }
@@ -7,6 +7,13 @@
 #include "Runtime/Engine/Classes/PhysicsEngine/PhysicsConstraintComponent.h"
 
 // CreatureMetaData
+uint32
+CreatureMetaData::MakeSerial()
+{
+	static volatile int32 last_serial = 0;
+	return (uint32)FPlatformAtomics::InterlockedIncrement(&last_serial);
+}
+
 void CreatureMetaData::buildSkinSwapIndices(
 	const FString & swap_name, 
 	meshRenderBoneComposition * bone_composition,
@@ -50,6 +57,35 @@ void CreatureMetaData::buildSkinSwapIndices(
 	}
 }
 
+void CreatureMetaData::buildRegionPointRanges(
+	const glm::uint32 * src_indices,
+	int num_indices,
+	TMap<int32, TTuple<int32, int32>>& region_pt_ranges
+) const
+{
+	region_pt_ranges.Empty(mesh_map.Num());
+	for (auto& mesh_data : mesh_map)
+	{
+		int32 start_idx = mesh_data.Value.Get<0>();
+		int32 end_idx = mesh_data.Value.Get<1>();
+		if ((start_idx < 0) || (end_idx >= num_indices) || (start_idx > end_idx))
+		{
+			continue;
+		}
+
+		// Regions own a contiguous range of points
+		int32 min_pt = (int32)src_indices[start_idx];
+		int32 max_pt = min_pt;
+		for (int32 i = start_idx + 1; i <= end_idx; i++)
+		{
+			min_pt = FMath::Min(min_pt, (int32)src_indices[i]);
+			max_pt = FMath::Max(max_pt, (int32)src_indices[i]);
+		}
+
+		region_pt_ranges.Add(mesh_data.Key, TTuple<int32, int32>(min_pt, max_pt));
+	}
+}
+
 // Bend Physics
 static void SetLinearLimits(
 	FConstraintInstance& Constraint,
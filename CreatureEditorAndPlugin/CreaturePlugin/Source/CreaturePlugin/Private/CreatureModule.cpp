@@ -40,6 +40,8 @@ DECLARE_CYCLE_STAT(TEXT("CreatureManager_Update"), STAT_CreatureManager_Update,
 DECLARE_CYCLE_STAT(TEXT("CreatureManager_IncreRunTime"), STAT_CreatureManager_IncreRunTime, STATGROUP_Creature);
 DECLARE_CYCLE_STAT(TEXT("CreatureManager_PoseJustBones"), STAT_CreatureManager_PoseJustBones, STATGROUP_Creature);
 DECLARE_CYCLE_STAT(TEXT("CreatureManager_PoseCreature"), STAT_CreatureManager_PoseCreature, STATGROUP_Creature);
+DECLARE_CYCLE_STAT(TEXT("CreatureManager_PoseCreatureBlended"), STAT_CreatureManager_PoseCreatureBlended, STATGROUP_Creature);
+DECLARE_CYCLE_STAT(TEXT("CreatureManager_ApplyBlendLayers"), STAT_CreatureManager_ApplyBlendLayers, STATGROUP_Creature);
 DECLARE_CYCLE_STAT(TEXT("CreatureManager_RunUVItemSwap"), STAT_CreatureManager_RunUVItemSwap, STATGROUP_Creature);
 DECLARE_CYCLE_STAT(TEXT("CreatureManager_AlterBonesByAnchor"), STAT_CreatureManager_AlterBonesByAnchor, STATGROUP_Creature);
 DECLARE_CYCLE_STAT(TEXT("CreatureManager_JustRunUVWarps"), STAT_CreatureManager_JustRunUVWarps, STATGROUP_Creature);
@@ -1014,7 +1016,7 @@ namespace CreatureModule {
     // CreatureAnimation class
     CreatureAnimation::CreatureAnimation(CreatureLoadDataPacket& load_data,
                                          const FName& name_in)
-    : name(name_in)
+    : name(name_in), cache_bounds_frames(0)
     {
             LoadFromData(name_in, load_data);
     }
@@ -1154,31 +1156,95 @@ namespace CreatureModule {
     }
     
     void
-    CreatureAnimation::poseFromCachePts(float time_in, glm::float32 * target_pts, int32 num_pts)
+    CreatureAnimation::poseFromCachePts(float time_in, const meshPointsSink& target_sink, int32 num_pts,
+                                        meshPointsBounds * bounds_out)
     {
         int32 cur_floor_time = getIndexByTime((int32)floorf(time_in));
         int32 cur_ceil_time = getIndexByTime((int32)ceilf(time_in));
         float cur_ratio = (time_in - (float)floorf(time_in));       
         
+		const int32 num_chunks = FMath::DivideAndRoundUp(num_pts, MESH_POSE_CHUNK_SIZE);
+		TArray<meshPointsBounds, TInlineAllocator<64>> chunk_bounds;
+		chunk_bounds.SetNum(bounds_out ? num_chunks : 0);
+
 #ifdef CREATURE_MULTICORE
-		ParallelFor(num_pts, [&](int32 i) {
+		ParallelFor(num_chunks, [&](int32 chunk_idx) {
 #else
-		for (int32 i = 0; i < num_pts; i++) {
+		for (int32 chunk_idx = 0; chunk_idx < num_chunks; chunk_idx++) {
 #endif
-			glm::float32 * set_pt = target_pts + (i * 3);
-			glm::float32 * floor_pts = cache_pts[cur_floor_time] + (i * 3);
-			glm::float32 * ceil_pts = cache_pts[cur_ceil_time] + (i * 3);
+			meshPointsBounds * cur_bounds = bounds_out ? &chunk_bounds[chunk_idx] : nullptr;
+			const int32 chunk_end = FMath::Min(num_pts, (chunk_idx + 1) * MESH_POSE_CHUNK_SIZE);
+			for (int32 i = chunk_idx * MESH_POSE_CHUNK_SIZE; i < chunk_end; i++)
+			{
+				glm::float32 * floor_pts = cache_pts[cur_floor_time] + (i * 3);
+				glm::float32 * ceil_pts = cache_pts[cur_ceil_time] + (i * 3);
+
+				glm::float32 set_x = ((1.0f - cur_ratio) * floor_pts[0]) + (cur_ratio * ceil_pts[0]);
+				glm::float32 set_y = ((1.0f - cur_ratio) * floor_pts[1]) + (cur_ratio * ceil_pts[1]);
+				target_sink.setPt(i, set_x, set_y);
 
-			set_pt[0] = ((1.0f - cur_ratio) * floor_pts[0]) + (cur_ratio * ceil_pts[0]);
-			set_pt[1] = ((1.0f - cur_ratio) * floor_pts[1]) + (cur_ratio * ceil_pts[1]);
-			set_pt[2] = ((1.0f - cur_ratio) * floor_pts[2]) + (cur_ratio * ceil_pts[2]);
+				if (cur_bounds)
+				{
+					cur_bounds->add(set_x, set_y);
+				}
+			}
 #ifdef CREATURE_MULTICORE
-		});
+		}, meshPoseSingleThreaded());
 #else
 		}
 #endif
-        
+
+		if (bounds_out)
+		{
+			for (const auto& cur_bounds : chunk_bounds)
+			{
+				bounds_out->add(cur_bounds);
+			}
+		}
     }
+
+	const meshPointsBounds&
+	CreatureAnimation::getCacheBounds(int32 num_pts)
+	{
+		if (cache_bounds_frames != cache_pts.Num())
+		{
+			cache_bounds.reset();
+			for (auto cur_pts : cache_pts)
+			{
+				for (int32 i = 0; i < num_pts; i++)
+				{
+					cache_bounds.add(cur_pts[i * 3], cur_pts[(i * 3) + 1]);
+				}
+			}
+
+			cache_bounds_frames = cache_pts.Num();
+		}
+
+		return cache_bounds;
+	}
+
+	TArray<meshPointsBounds>&
+	CreatureAnimation::getFrameBounds()
+	{
+		return frame_bounds;
+	}
+
+	bool
+	CreatureAnimation::addFrameBoundsAtTime(float time_in, meshPointsBounds& bounds_out) const
+	{
+		if (frame_bounds.Num() == 0)
+		{
+			return false;
+		}
+
+		// Points in between two frames are interpolated, so they stay inside the bounds of both
+		int32 floor_idx = clipNum((int32)floorf(time_in) - (int32)start_time, 0, frame_bounds.Num() - 1);
+		int32 ceil_idx = clipNum((int32)ceilf(time_in) - (int32)start_time, 0, frame_bounds.Num() - 1);
+		bounds_out.add(frame_bounds[floor_idx]);
+		bounds_out.add(frame_bounds[ceil_idx]);
+
+		return true;
+	}
     
     // CreatureManager class
     CreatureManager::CreatureManager(TSharedPtr<CreatureModule::Creature> target_creature_in)
@@ -1186,11 +1252,21 @@ namespace CreatureModule {
         do_blending(false),
         blending_factor(0), mirror_y(false), use_custom_time_range(false),
         custom_start_time(0), custom_end_time(0), should_loop(true),
-        do_auto_blending(false), auto_blend_delta(0.1f), do_point_caching(false)
+        do_auto_blending(false), auto_blend_delta(0.1f), do_point_caching(false),
+        render_points_serial(0), use_clip_bounds(false), blend_layers_serial(0)
     {
         for(int32 i = 0; i < 2; i++) {
             blend_render_pts[i] = NULL;
         }
+
+		// Blend and layer scratch is sized for the whole character up front, so posing never grows it
+		if (target_creature.IsValid())
+		{
+			const int32 num_bones = target_creature->GetRenderComposition()->getBonesMap().Num();
+			blend_bone_pts.Reserve(num_bones * 2);
+			layer_pose_pts.Reserve(num_bones * 2);
+			blend_displacements.Reserve(target_creature->GetTotalNumPoints() * 2);
+		}
     }
     
     CreatureManager::~CreatureManager()
@@ -1290,6 +1366,26 @@ namespace CreatureModule {
 		}
 	}
 
+	void
+	CreatureManager::UpdateBlendRegionSwitches(const FName& name_1, const FName& name_2)
+	{
+		UpdateRegionSwitches(name_2);
+
+		TArray<meshDisplacementCache>& displacement_table =
+			animations[name_1]->getDisplacementCache().getCacheTable()[0];
+		TArray<meshRenderRegion *>& all_regions =
+			target_creature->GetRenderComposition()->getRegions();
+
+		// An animation without displacements on a region blends in zero displacements
+		for (int32 i = 0; i < all_regions.Num(); i++) {
+			meshRenderRegion * cur_region = all_regions[i];
+			cur_region->setUseLocalDisplacements(cur_region->getUseLocalDisplacements()
+				|| (displacement_table[i].getLocalDisplacements().Num() > 0));
+			cur_region->setUsePostDisplacements(cur_region->getUsePostDisplacements()
+				|| (displacement_table[i].getPostDisplacements().Num() > 0));
+		}
+	}
+
     const FName&
     CreatureManager::GetActiveAnimationName() const
     {
@@ -1470,7 +1566,7 @@ namespace CreatureModule {
         {
             run_time = (float)i;
 			auto new_pts = new glm::float32[array_size];
-            PoseCreature(animation_name_in, new_pts, getRunTime());
+            PoseCreature(animation_name_in, meshPointsSink(new_pts), getRunTime());
             
 			int32 real_step = gap_step;
 			if (i + real_step > cur_animation->getEndTime())
@@ -1519,8 +1615,10 @@ namespace CreatureModule {
 
     void
     CreatureManager::PoseCreature(const FName& animation_name_in,
-                                  glm::float32 * target_pts,
-								  float input_run_time)
+                                  const meshPointsSink& target_sink,
+								  float input_run_time,
+								  meshPointsBounds * bounds_out,
+								  bool with_blend_layers)
     {
 		SCOPE_CYCLE_COUNTER(STAT_CreatureManager_PoseCreature);
         if(animations.Contains(animation_name_in) == false)
@@ -1531,53 +1629,438 @@ namespace CreatureModule {
             return;
         }
         
-        auto& cur_animation = animations[animation_name_in];
-        
-        auto& bone_cache_manager = cur_animation->getBonesCache();
-        auto& displacement_cache_manager = cur_animation->getDisplacementCache();
-        auto& uv_warp_cache_manager = cur_animation->getUVWarpCache();
-		auto& opacity_cache_manager = cur_animation->getOpacityCache();
-        
-        meshRenderBoneComposition * render_composition =
-        target_creature->GetRenderComposition();
-        
-        // Extract values from caches
-        TMap<FName, meshBone *>& bones_map =
-        render_composition->getBonesMap();
-        TMap<FName, meshRenderRegion *>& regions_map =
-        render_composition->getRegionsMap();
-        
-		bone_cache_manager.retrieveValuesAtTime(input_run_time,
-                                                bones_map);
+        RetrieveClipValues(animation_name_in, input_run_time);
 
-		AlterBonesByAnchor(bones_map, animation_name_in);
+		if (with_blend_layers)
+		{
+			ApplyBlendLayers();
+		}
         
         if(bones_override_callback)
         {
-            bones_override_callback(bones_map);
+            bones_override_callback(target_creature->GetRenderComposition()->getBonesMap());
         }
         
-		displacement_cache_manager.retrieveValuesAtTime(input_run_time,
-                                                        regions_map);
-		uv_warp_cache_manager.retrieveValuesAtTime(input_run_time,
-                                                   regions_map);
-		opacity_cache_manager.retrieveValuesAtTime(input_run_time,
-													regions_map);
-        
-        
-        // Do posing, decide if we are blending or not
-        TArray<meshRenderRegion *>& cur_regions =
-        render_composition->getRegions();
+		RetrieveClipAttributes(animation_name_in, input_run_time);
         
-        render_composition->updateAllTransforms(false);
-        for(auto j = 0; j < cur_regions.Num(); j++) {
-            meshRenderRegion * cur_region = cur_regions[j];
-            
-            int32 cur_pt_index = cur_region->getStartPtIndex();
-            cur_region->poseFastFinalPts(target_pts + (cur_pt_index * 3));
-        }
-
+		PoseRegions(target_sink, bounds_out);
     }
+
+	void
+	CreatureManager::RetrieveClipValues(const FName& animation_name_in, float input_run_time)
+	{
+		auto& cur_animation = animations[animation_name_in];
+		meshRenderBoneComposition * render_composition =
+			target_creature->GetRenderComposition();
+		TMap<FName, meshBone *>& bones_map =
+			render_composition->getBonesMap();
+
+		cur_animation->getBonesCache().retrieveValuesAtTime(GetBonesRunTime(cur_animation.Get(), input_run_time),
+															bones_map);
+
+		AlterBonesByAnchor(bones_map, animation_name_in);
+
+		if (!lod_settings.skip_displacements)
+		{
+			cur_animation->getDisplacementCache().retrieveValuesAtTime(input_run_time,
+																	   render_composition->getRegionsMap());
+		}
+	}
+
+	float
+	CreatureManager::GetBonesRunTime(CreatureAnimation * animation_in, float input_run_time) const
+	{
+		if (lod_settings.bone_sample_step <= 1)
+		{
+			return input_run_time;
+		}
+
+		float sample_step = (float)lod_settings.bone_sample_step;
+		return FMath::Max(floorf(input_run_time / sample_step) * sample_step, animation_in->getStartTime());
+	}
+
+	void
+	CreatureManager::FlattenBones(TArray<glm::vec4>& pts_out)
+	{
+		TMap<FName, meshBone *>& bones_map =
+			target_creature->GetRenderComposition()->getBonesMap();
+
+		pts_out.SetNumUninitialized(bones_map.Num() * 2, false);
+		int32 bone_idx = 0;
+		for (auto& cur_bone : bones_map)
+		{
+			pts_out[bone_idx++] = cur_bone.Value->getWorldStartPt();
+			pts_out[bone_idx++] = cur_bone.Value->getWorldEndPt();
+		}
+	}
+
+	void
+	CreatureManager::ApplyBlendLayers()
+	{
+		if (!HasActiveBlendLayers())
+		{
+			return;
+		}
+
+		SCOPE_CYCLE_COUNTER(STAT_CreatureManager_ApplyBlendLayers);
+
+		TMap<FName, meshBone *>& bones_map =
+			target_creature->GetRenderComposition()->getBonesMap();
+
+		FlattenBones(layer_pose_pts);
+		const int32 num_bones = bones_map.Num();
+
+		for (auto& cur_layer : blend_layers)
+		{
+			if ((cur_layer.weight <= 0.0f) || (animations.Contains(cur_layer.animation_name) == false))
+			{
+				continue;
+			}
+
+			// Layers that did not move since their last sample, like held poses, reuse the sampled bones
+			auto& cur_animation = animations[cur_layer.animation_name];
+			const float bones_run_time = GetBonesRunTime(cur_animation.Get(), cur_layer.run_time);
+			if ((cur_layer.sampled_time != bones_run_time) || (cur_layer.sampled_bone_pts.Num() != layer_pose_pts.Num()))
+			{
+				cur_animation->getBonesCache().retrieveValuesAtTime(bones_run_time, bones_map);
+				AlterBonesByAnchor(bones_map, cur_layer.animation_name);
+				FlattenBones(cur_layer.sampled_bone_pts);
+				cur_layer.sampled_time = bones_run_time;
+			}
+
+			const bool use_mask = (cur_layer.bone_mask.Num() == num_bones);
+			const TArray<glm::vec4>& layer_pts = cur_layer.sampled_bone_pts;
+			if (cur_layer.additive)
+			{
+				const TArray<glm::vec4>& reference_pts = GetAdditiveReference(cur_layer.animation_name);
+				for (int32 i = 0; i < num_bones; i++)
+				{
+					const float bone_weight = use_mask ? (cur_layer.weight * cur_layer.bone_mask[i]) : cur_layer.weight;
+					for (int32 j = i * 2; (bone_weight > 0.0f) && (j < (i * 2) + 2); j++)
+					{
+						layer_pose_pts[j] += bone_weight * (layer_pts[j] - reference_pts[j]);
+					}
+				}
+			}
+			else {
+				for (int32 i = 0; i < num_bones; i++)
+				{
+					const float bone_weight = FMath::Min(use_mask ? (cur_layer.weight * cur_layer.bone_mask[i]) : cur_layer.weight, 1.0f);
+					for (int32 j = i * 2; (bone_weight > 0.0f) && (j < (i * 2) + 2); j++)
+					{
+						layer_pose_pts[j] = ((1.0f - bone_weight) * layer_pose_pts[j]) + (bone_weight * layer_pts[j]);
+					}
+				}
+			}
+		}
+
+		int32 bone_idx = 0;
+		for (auto& cur_bone : bones_map)
+		{
+			cur_bone.Value->setWorldStartPt(layer_pose_pts[bone_idx]);
+			cur_bone.Value->setWorldEndPt(layer_pose_pts[bone_idx + 1]);
+			bone_idx += 2;
+		}
+	}
+
+	const TArray<glm::vec4>&
+	CreatureManager::GetAdditiveReference(const FName& animation_name_in)
+	{
+		TArray<glm::vec4> * found_pts = additive_reference_pts.Find(animation_name_in);
+		if (found_pts)
+		{
+			return *found_pts;
+		}
+
+		auto& cur_animation = animations[animation_name_in];
+		TMap<FName, meshBone *>& bones_map =
+			target_creature->GetRenderComposition()->getBonesMap();
+		cur_animation->getBonesCache().retrieveValuesAtTime(cur_animation->getStartTime(), bones_map);
+		AlterBonesByAnchor(bones_map, animation_name_in);
+
+		TArray<glm::vec4>& new_pts = additive_reference_pts.Add(animation_name_in);
+		FlattenBones(new_pts);
+
+		return new_pts;
+	}
+
+	void
+	CreatureManager::SetBlendLayers(const TArray<CreatureBlendLayer>& layers_in)
+	{
+		blend_layers_serial++;
+		const int32 old_num = blend_layers.Num();
+		blend_layers.SetNum(layers_in.Num());
+
+		for (int32 i = 0; i < layers_in.Num(); i++)
+		{
+			const CreatureBlendLayer& src_layer = layers_in[i];
+			CreatureBlendLayer& dst_layer = blend_layers[i];
+
+			const bool keep_playing = (i < old_num)
+				&& (dst_layer.animation_name == src_layer.animation_name)
+				&& (dst_layer.play_serial == src_layer.play_serial);
+			if (!keep_playing)
+			{
+				auto * found_animation = animations.Find(src_layer.animation_name);
+				dst_layer.run_time = found_animation ? (*found_animation)->getStartTime() : 0.0f;
+				dst_layer.sampled_time = -1.0f;
+			}
+
+			dst_layer.animation_name = src_layer.animation_name;
+			dst_layer.weight = src_layer.weight;
+			dst_layer.additive = src_layer.additive;
+			dst_layer.loop = src_layer.loop;
+			dst_layer.bone_mask = src_layer.bone_mask;
+			dst_layer.play_serial = src_layer.play_serial;
+		}
+	}
+
+	const TArray<CreatureBlendLayer>&
+	CreatureManager::GetBlendLayers() const
+	{
+		return blend_layers;
+	}
+
+	bool
+	CreatureManager::HasActiveBlendLayers() const
+	{
+		for (const auto& cur_layer : blend_layers)
+		{
+			if ((cur_layer.weight > 0.0f) && animations.Contains(cur_layer.animation_name))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void
+	CreatureManager::MakeBoneMask(const TMap<FName, float>& bone_weights_in, bool include_children, TArray<float>& mask_out)
+	{
+		TMap<FName, meshBone *>& bones_map =
+			target_creature->GetRenderComposition()->getBonesMap();
+
+		mask_out.Reset(bones_map.Num());
+		for (auto& cur_bone : bones_map)
+		{
+			float cur_weight = 0.0f;
+			meshBone * check_bone = cur_bone.Value;
+			while (check_bone)
+			{
+				const float * found_weight = bone_weights_in.Find(check_bone->getKey());
+				if (found_weight)
+				{
+					cur_weight = *found_weight;
+					break;
+				}
+
+				check_bone = include_children ? check_bone->getParent() : nullptr;
+			}
+
+			mask_out.Add(cur_weight);
+		}
+	}
+
+	void
+	CreatureManager::increBlendLayerRuntimes(float delta_in)
+	{
+		for (auto& cur_layer : blend_layers)
+		{
+			auto * found_animation = animations.Find(cur_layer.animation_name);
+			if (found_animation == nullptr)
+			{
+				continue;
+			}
+
+			const float anim_start_time = (*found_animation)->getStartTime();
+			const float anim_end_time = (*found_animation)->getEndTime();
+			cur_layer.run_time += delta_in;
+			if (cur_layer.run_time > anim_end_time)
+			{
+				cur_layer.run_time = cur_layer.loop ? anim_start_time : anim_end_time;
+			}
+		}
+	}
+
+	void
+	CreatureManager::RetrieveClipAttributes(const FName& animation_name_in, float input_run_time)
+	{
+		auto& cur_animation = animations[animation_name_in];
+		TMap<FName, meshRenderRegion *>& regions_map =
+			target_creature->GetRenderComposition()->getRegionsMap();
+
+		if (!lod_settings.skip_uv_warps)
+		{
+			cur_animation->getUVWarpCache().retrieveValuesAtTime(input_run_time,
+																 regions_map);
+		}
+
+		cur_animation->getOpacityCache().retrieveValuesAtTime(input_run_time,
+															  regions_map);
+	}
+
+	void
+	CreatureManager::PoseRegions(const meshPointsSink& target_sink,
+								 meshPointsBounds * bounds_out)
+	{
+		meshRenderBoneComposition * render_composition =
+			target_creature->GetRenderComposition();
+		TArray<meshRenderRegion *>& cur_regions =
+			render_composition->getRegions();
+
+		render_composition->updateAllTransforms(false);
+		for (auto j = 0; j < cur_regions.Num(); j++) {
+			meshRenderRegion * cur_region = cur_regions[j];
+
+			int32 cur_pt_index = cur_region->getStartPtIndex();
+			cur_region->poseFastFinalPts(target_sink.offset(cur_pt_index),
+										 !lod_settings.skip_displacements,
+										 !lod_settings.skip_displacements,
+										 !lod_settings.skip_uv_warps,
+										 bounds_out);
+		}
+	}
+
+	void
+	CreatureManager::PoseCreatureBlended(const meshPointsSink& target_sink,
+										 meshPointsBounds * bounds_out)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_CreatureManager_PoseCreatureBlended);
+
+		const FName& name_1 = active_blend_animation_names[0];
+		const FName& name_2 = active_blend_animation_names[1];
+		meshRenderBoneComposition * render_composition =
+			target_creature->GetRenderComposition();
+		TMap<FName, meshBone *>& bones_map =
+			render_composition->getBonesMap();
+		TArray<meshRenderRegion *>& cur_regions =
+			render_composition->getRegions();
+
+		UpdateBlendRegionSwitches(name_1, name_2);
+
+		// Flatten the first animation's bones and displacements
+		RetrieveClipValues(name_1, active_blend_run_times[name_1]);
+		FlattenBones(blend_bone_pts);
+
+		blend_displacements.Reset();
+		for (auto cur_region : cur_regions)
+		{
+			if (cur_region->getUseLocalDisplacements())
+			{
+				blend_displacements.Append(cur_region->getLocalDisplacements());
+			}
+
+			if (cur_region->getUsePostDisplacements())
+			{
+				blend_displacements.Append(cur_region->getPostDisplacements());
+			}
+		}
+
+		// Blend them with the second animation's values
+		RetrieveClipValues(name_2, active_blend_run_times[name_2]);
+
+		const float factor_1 = 1.0f - blending_factor;
+		const float factor_2 = blending_factor;
+		int32 bone_idx = 0;
+		for (auto& cur_bone : bones_map)
+		{
+			meshBone * set_bone = cur_bone.Value;
+			set_bone->setWorldStartPt((factor_1 * blend_bone_pts[bone_idx]) + (factor_2 * set_bone->getWorldStartPt()));
+			set_bone->setWorldEndPt((factor_1 * blend_bone_pts[bone_idx + 1]) + (factor_2 * set_bone->getWorldEndPt()));
+			bone_idx += 2;
+		}
+
+		if (!lod_settings.skip_displacements)
+		{
+			int32 displacement_idx = 0;
+			auto blend_displacements_list = [&](TArray<glm::vec2>& displacements)
+			{
+				for (auto& cur_displacement : displacements)
+				{
+					cur_displacement = (factor_1 * blend_displacements[displacement_idx]) + (factor_2 * cur_displacement);
+					displacement_idx++;
+				}
+			};
+
+			for (auto cur_region : cur_regions)
+			{
+				if (cur_region->getUseLocalDisplacements())
+				{
+					blend_displacements_list(cur_region->getLocalDisplacements());
+				}
+
+				if (cur_region->getUsePostDisplacements())
+				{
+					blend_displacements_list(cur_region->getPostDisplacements());
+				}
+			}
+		}
+
+		ApplyBlendLayers();
+
+		if (bones_override_callback)
+		{
+			bones_override_callback(bones_map);
+		}
+
+		// Uv warps and opacities do not blend, they come from the animation being blended into
+		RetrieveClipAttributes(name_2, active_blend_run_times[name_2]);
+
+		PoseRegions(target_sink, bounds_out);
+	}
+
+	void
+	CreatureManager::PoseBlendedPoints(const meshPointsSink& target_sink,
+									   meshPointsBounds * bounds_out)
+	{
+		for (int32 i = 0; i < 2; i++) {
+			auto& cur_animation_name = active_blend_animation_names[i];
+			auto& cur_animation = animations[cur_animation_name];
+			auto& cur_animation_run_time = active_blend_run_times[cur_animation_name];
+
+			if (cur_animation->hasCachePts() && do_point_caching)
+			{
+				UpdateRegionSwitches(cur_animation_name);
+				PoseFromCache(cur_animation.Get(), cur_animation_run_time, meshPointsSink(blend_render_pts[i]), nullptr);
+				PoseJustBones(cur_animation_name, cur_animation_run_time);
+			}
+			else {
+				UpdateRegionSwitches(active_blend_animation_names[i]);
+				PoseCreature(active_blend_animation_names[i], meshPointsSink(blend_render_pts[i]), cur_animation_run_time, nullptr, true);
+			}
+		}
+
+		for (int32 j = 0; j < target_creature->GetTotalNumPoints(); j++)
+		{
+			glm::float32 * read_data_1 = blend_render_pts[0] + (j * 3);
+			glm::float32 * read_data_2 = blend_render_pts[1] + (j * 3);
+
+			glm::float32 set_x = ((1.0f - blending_factor) * read_data_1[0]) + (blending_factor * read_data_2[0]);
+			glm::float32 set_y = ((1.0f - blending_factor) * read_data_1[1]) + (blending_factor * read_data_2[1]);
+			target_sink.setPt(j, set_x, set_y);
+			if (bounds_out)
+			{
+				bounds_out->add(set_x, set_y);
+			}
+		}
+	}
+
+	void
+	CreatureManager::PoseFromCache(CreatureAnimation * animation_in,
+								   float input_run_time,
+								   const meshPointsSink& target_sink,
+								   meshPointsBounds * bounds_out)
+	{
+		const int32 num_pts = target_creature->GetTotalNumPoints();
+		if (use_clip_bounds && bounds_out)
+		{
+			bounds_out->add(animation_in->getCacheBounds(num_pts));
+			bounds_out = nullptr;
+		}
+
+		animation_in->poseFromCachePts(input_run_time, target_sink, num_pts, bounds_out);
+	}
     
     void
     CreatureManager::ProcessAutoBlending()
@@ -1732,53 +2215,42 @@ namespace CreatureModule {
             return;
         }
         
-        increRunTime(delta * time_scale);
-        
-        if(do_auto_blending)
+        AdvanceTime(delta);
+		PoseCurrentTime();
+    }
+
+	void
+	CreatureManager::PoseCurrentTime()
+	{
+        if(!is_playing)
         {
-            ProcessAutoBlending();
-			// process run times for blends
-			increAutoBlendRuntimes(delta * time_scale);
+            return;
         }
+
+		render_points_bounds.reset();
         
         if(do_blending && checkAnimationBlendValid())
         {
-            for(int32 i = 0; i < 2; i++) {
-				auto& cur_animation_name = active_blend_animation_names[i];
-				auto& cur_animation = animations[cur_animation_name];
-				auto& cur_animation_run_time = active_blend_run_times[cur_animation_name];
-
-                if(cur_animation->hasCachePts() && do_point_caching)
-                {
-					UpdateRegionSwitches(cur_animation_name);
-					cur_animation->poseFromCachePts(cur_animation_run_time, blend_render_pts[i], target_creature->GetTotalNumPoints());
-					PoseJustBones(cur_animation_name, cur_animation_run_time);
-                }
-                else {
-					UpdateRegionSwitches(active_blend_animation_names[i]);
-					PoseCreature(active_blend_animation_names[i], blend_render_pts[i], cur_animation_run_time);
-                }
-            }
-            
-            for(int32 j = 0; j < target_creature->GetTotalNumPoints() * 3; j++)
-            {
-                glm::float32 * set_data = target_creature->GetRenderPts() + j;
-                glm::float32 * read_data_1 = blend_render_pts[0] + j;
-                glm::float32 * read_data_2 = blend_render_pts[1] + j;
-                
-                *set_data = ((1.0f - blending_factor) * (*read_data_1)) +
-                (blending_factor * (*read_data_2));
-            }
+			// Point cached animations only have posed points, so those still blend after posing
+			const bool blend_points = do_point_caching && !HasActiveBlendLayers()
+				&& (animations[active_blend_animation_names[0]]->hasCachePts() || animations[active_blend_animation_names[1]]->hasCachePts());
+			if (blend_points)
+			{
+				PoseBlendedPoints(GetRenderPointsSink(), &render_points_bounds);
+			}
+			else {
+				PoseCreatureBlended(GetRenderPointsSink(), &render_points_bounds);
+			}
         }
         else {
             auto& cur_animation = animations[active_animation_name];
-            if(cur_animation->hasCachePts() && do_point_caching)
+            if(cur_animation->hasCachePts() && do_point_caching && !HasActiveBlendLayers())
             {
-				cur_animation->poseFromCachePts(getRunTime(), target_creature->GetRenderPts(), target_creature->GetTotalNumPoints());
+				PoseFromCache(cur_animation.Get(), getRunTime(), GetRenderPointsSink(), &render_points_bounds);
 				PoseJustBones(active_animation_name, getRunTime());
             }
             else {
-				PoseCreature(active_animation_name, target_creature->GetRenderPts(), getRunTime());
+				PoseCreature(active_animation_name, GetRenderPointsSink(), getRunTime(), &render_points_bounds, true);
             }
         }
 
@@ -1786,14 +2258,213 @@ namespace CreatureModule {
         
         if(mirror_y)
         {
-            glm::float32 * set_data = target_creature->GetRenderPts();
+            const meshPointsSink target_sink = GetRenderPointsSink();
             for(int32 j = 0; j < target_creature->GetTotalNumPoints(); j++)
             {
-                set_data[0] = -set_data[0];
-                set_data += 3;
+                glm::float32 * set_data = target_sink.getPt(j);
+                set_data[target_sink.x_id] = -set_data[target_sink.x_id];
             }
+
+            render_points_bounds.mirrorX();
+        }
+
+		render_points_serial++;
+    }
+
+	static uint32 QuantizePoseTime(float time_in, float time_step = 0.0f)
+	{
+		if (time_step > 0.0f)
+		{
+			return (uint32)FMath::FloorToInt(time_in / time_step);
+		}
+
+		return (uint32)FMath::RoundToInt(time_in * 1000.0f);
+	}
+
+	bool
+	CreatureManager::GetPoseInputKey(CreaturePoseKey& key_out, float time_step)
+	{
+		// Bones changed by a callback can not be told apart between updates
+		if (bones_override_callback)
+		{
+			return false;
+		}
+
+		key_out.addName(active_animation_name);
+		key_out.add(QuantizePoseTime(run_time, time_step));
+		key_out.add(is_playing ? 1 : 0);
+
+		const bool is_blending = do_blending && checkAnimationBlendValid();
+		key_out.add(is_blending ? 1 : 0);
+		if (is_blending)
+		{
+			key_out.add((uint32)active_blend_animation_names.Num());
+			for (const FName& cur_name : active_blend_animation_names)
+			{
+				const float * cur_time = active_blend_run_times.Find(cur_name);
+				key_out.addName(cur_name);
+				key_out.add(QuantizePoseTime(cur_time ? *cur_time : 0.0f, time_step));
+			}
+
+			key_out.add(QuantizePoseTime(blending_factor));
+		}
+
+		key_out.add((uint32)blend_layers_serial);
+		key_out.add((uint32)blend_layers.Num());
+		for (const auto& cur_layer : blend_layers)
+		{
+			key_out.add(QuantizePoseTime(cur_layer.run_time, time_step));
+		}
+
+		key_out.add(mirror_y ? 1 : 0);
+		key_out.add(do_point_caching ? 1 : 0);
+		key_out.add(use_clip_bounds ? 1 : 0);
+		key_out.add(target_creature->GetAnchorPointsActive() ? 1 : 0);
+		key_out.add((uint32)lod_settings.max_bone_influences);
+		key_out.add((uint32)lod_settings.bone_sample_step);
+		key_out.add(lod_settings.skip_displacements ? 1 : 0);
+		key_out.add(lod_settings.skip_uv_warps ? 1 : 0);
+
+		const auto& item_swaps = target_creature->GetActiveItemSwaps();
+		key_out.add((uint32)item_swaps.Num());
+		for (const auto& cur_swap : item_swaps)
+		{
+			key_out.addName(cur_swap.Key);
+			key_out.add((uint32)cur_swap.Value);
+		}
+
+		return true;
+	}
+
+	void
+	CreatureManager::SetPosedPoints(const glm::float32 * xy_pts_in, const meshPointsBounds& bounds_in)
+	{
+		const meshPointsSink target_sink = GetRenderPointsSink();
+		for (int32 i = 0; i < target_creature->GetTotalNumPoints(); i++)
+		{
+			const glm::float32 * read_pt = xy_pts_in + (i * 2);
+			target_sink.setPt(i, read_pt[0], read_pt[1]);
+		}
+
+		render_points_bounds = bounds_in;
+		render_points_serial++;
+	}
+
+    void
+    CreatureManager::AdvanceTime(float delta)
+    {
+        if(!is_playing)
+        {
+            return;
+        }
+        
+        increRunTime(delta * time_scale);
+        
+        if(do_auto_blending)
+        {
+            ProcessAutoBlending();
+			// process run times for blends
+			increAutoBlendRuntimes(delta * time_scale);
         }
+
+		increBlendLayerRuntimes(delta * time_scale);
     }
+
+	void
+	CreatureManager::SetRenderPointsSink(const meshPointsSink& sink_in)
+	{
+		render_points_sink = sink_in;
+	}
+
+	void
+	CreatureManager::ClearRenderPointsSink()
+	{
+		render_points_sink = meshPointsSink();
+	}
+
+	meshPointsSink
+	CreatureManager::GetRenderPointsSink() const
+	{
+		if (render_points_sink.isValid())
+		{
+			return render_points_sink;
+		}
+
+		return meshPointsSink(target_creature->GetRenderPts());
+	}
+
+	int32
+	CreatureManager::GetRenderPointsSerial() const
+	{
+		return render_points_serial;
+	}
+
+	const meshPointsBounds&
+	CreatureManager::GetRenderPointsBounds() const
+	{
+		return render_points_bounds;
+	}
+
+	void
+	CreatureManager::SetUseClipBounds(bool flag_in)
+	{
+		use_clip_bounds = flag_in;
+	}
+
+	void
+	CreatureManager::SetLodSettings(const CreatureLodSettings& settings_in)
+	{
+		if (lod_settings == settings_in)
+		{
+			return;
+		}
+
+		lod_settings = settings_in;
+
+		TArray<meshRenderRegion *>& cur_regions = target_creature->GetRenderComposition()->getRegions();
+		for (auto cur_region : cur_regions)
+		{
+			cur_region->setMaxBoneInfluences(lod_settings.max_bone_influences);
+		}
+	}
+
+	const CreatureLodSettings&
+	CreatureManager::GetLodSettings() const
+	{
+		return lod_settings;
+	}
+
+	bool
+	CreatureManager::GetBakedBounds(meshPointsBounds& bounds_out)
+	{
+		bounds_out.reset();
+
+		if (do_blending && checkAnimationBlendValid())
+		{
+			for (int32 i = 0; i < 2; i++)
+			{
+				auto& cur_animation_name = active_blend_animation_names[i];
+				if (!animations[cur_animation_name]->addFrameBoundsAtTime(active_blend_run_times[cur_animation_name], bounds_out))
+				{
+					return false;
+				}
+			}
+		}
+		else {
+			auto cur_animation = animations.Find(active_animation_name);
+			if ((cur_animation == nullptr) || !(*cur_animation)->addFrameBoundsAtTime(getRunTime(), bounds_out))
+			{
+				return false;
+			}
+		}
+
+		if (mirror_y)
+		{
+			bounds_out.mirrorX();
+		}
+
+		return bounds_out.isValid();
+	}
     
     void
     CreatureManager::SetMirrorY(bool flag_in)
@@ -0,0 +1,93 @@
+#include "CreaturePluginPCH.h"
+#include "CreaturePoseCache.h"
+
+FCriticalSection FCreaturePoseCache::cache_lock;
+TArray<FCreatureSharedPosePtr> FCreaturePoseCache::cached_poses;
+TMap<uint32, int32> FCreaturePoseCache::pose_slots;
+TArray<FCreatureSharedPosePtr> FCreaturePoseCache::free_poses;
+uint64 FCreaturePoseCache::cache_frame = 0;
+
+void FCreaturePoseCache::BeginFrame()
+{
+	if (cache_frame != GFrameCounter)
+	{
+		cache_frame = GFrameCounter;
+
+		for (FCreatureSharedPosePtr& cur_pose : cached_poses)
+		{
+			if (cur_pose.IsUnique())
+			{
+				free_poses.Add(cur_pose);
+			}
+		}
+
+		cached_poses.Reset();
+		pose_slots.Reset();
+	}
+}
+
+int32 FCreaturePoseCache::FindIndex(const CreatureModule::CreaturePoseKey& key_in)
+{
+	const int32 * first_idx = pose_slots.Find(key_in.hash);
+	for (int32 cur_idx = first_idx ? *first_idx : INDEX_NONE; cur_idx != INDEX_NONE; cur_idx = cached_poses[cur_idx]->next_same_hash)
+	{
+		if (cached_poses[cur_idx]->key == key_in)
+		{
+			return cur_idx;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+FCreatureSharedPosePtr FCreaturePoseCache::Find(const CreatureModule::CreaturePoseKey& key_in)
+{
+	FScopeLock scope_lock(&cache_lock);
+	BeginFrame();
+
+	const int32 found_idx = FindIndex(key_in);
+	return (found_idx != INDEX_NONE) ? cached_poses[found_idx] : FCreatureSharedPosePtr();
+}
+
+FCreatureSharedPosePtr FCreaturePoseCache::Acquire()
+{
+	FScopeLock scope_lock(&cache_lock);
+	BeginFrame();
+
+	if (free_poses.Num() > 0)
+	{
+		return free_poses.Pop(false);
+	}
+
+	return FCreatureSharedPosePtr(new FCreatureSharedPose());
+}
+
+void FCreaturePoseCache::Add(const CreatureModule::CreaturePoseKey& key_in, const FCreatureSharedPosePtr& pose_in)
+{
+	FScopeLock scope_lock(&cache_lock);
+	BeginFrame();
+
+	if (FindIndex(key_in) != INDEX_NONE)
+	{
+		// Another instance was first, the pose goes back to the pool
+		free_poses.Add(pose_in);
+		return;
+	}
+
+	// Copied element by element, so a pooled key keeps its memory
+	pose_in->key.words.Reset(key_in.words.Num());
+	pose_in->key.words.Append(key_in.words);
+	pose_in->key.hash = key_in.hash;
+
+	const int32 new_idx = cached_poses.Add(pose_in);
+	int32 * first_idx = pose_slots.Find(key_in.hash);
+	if (first_idx)
+	{
+		pose_in->next_same_hash = *first_idx;
+		*first_idx = new_idx;
+	}
+	else {
+		pose_in->next_same_hash = INDEX_NONE;
+		pose_slots.Add(key_in.hash, new_idx);
+	}
+}
@@ -0,0 +1,396 @@
+
+#include "CreaturePluginPCH.h"
+#include "CreatureUpdateScheduler.h"
+#include "CreatureMeshComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("CreatureScheduler_Dispatch"), STAT_CreatureScheduler_Dispatch, STATGROUP_Creature);
+DECLARE_CYCLE_STAT(TEXT("CreatureScheduler_RunUpdates"), STAT_CreatureScheduler_RunUpdates, STATGROUP_Creature);
+DECLARE_CYCLE_STAT(TEXT("CreatureScheduler_Wait"), STAT_CreatureScheduler_Wait, STATGROUP_Creature);
+DECLARE_CYCLE_STAT(TEXT("CreatureScheduler_LateUpdate"), STAT_CreatureScheduler_LateUpdate, STATGROUP_Creature);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CreatureScheduler_LateUpdates"), STAT_CreatureScheduler_LateUpdates, STATGROUP_Creature);
+
+static TAutoConsoleVariable<float> CVarCreatureUpdateBudgetMs(
+	TEXT("creature.UpdateBudgetMs"),
+	0.0f,
+	TEXT("CPU time in milliseconds all creature updates of a world may take per frame.\n")
+	TEXT("0: no budget, every creature poses when it wants to"),
+	ECVF_Default);
+
+// Budget entries of components that stopped asking for updates are dropped after this many frames
+static const uint64 CREATURE_BUDGET_STALE_FRAMES = 120;
+
+TMap<UWorld *, FCreatureUpdateScheduler *> FCreatureUpdateScheduler::world_schedulers;
+
+void FCreatureSchedulerTickFunction::ExecuteTick(float DeltaTime, enum ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (is_fence)
+	{
+		Target->WaitAndProcessResults();
+	}
+	else {
+		Target->Dispatch();
+	}
+}
+
+FString FCreatureSchedulerTickFunction::DiagnosticMessage()
+{
+	return is_fence ? TEXT("FCreatureUpdateScheduler_Fence") : TEXT("FCreatureUpdateScheduler_Dispatch");
+}
+
+FCreatureUpdateScheduler * FCreatureUpdateScheduler::Get(UWorld * world_in)
+{
+	check(IsInGameThread());
+
+	FCreatureUpdateScheduler ** found_scheduler = world_schedulers.Find(world_in);
+	if (found_scheduler)
+	{
+		return *found_scheduler;
+	}
+
+	static bool registered_cleanup = false;
+	if (!registered_cleanup)
+	{
+		FWorldDelegates::OnWorldCleanup.AddStatic(&FCreatureUpdateScheduler::OnWorldCleanup);
+		registered_cleanup = true;
+	}
+
+	FCreatureUpdateScheduler * new_scheduler = new FCreatureUpdateScheduler(world_in);
+	world_schedulers.Add(world_in, new_scheduler);
+
+	return new_scheduler;
+}
+
+FCreatureUpdateScheduler * FCreatureUpdateScheduler::Find(UWorld * world_in)
+{
+	check(IsInGameThread());
+
+	FCreatureUpdateScheduler ** found_scheduler = world_schedulers.Find(world_in);
+	return found_scheduler ? *found_scheduler : nullptr;
+}
+
+FCreatureUpdateScheduler::FCreatureUpdateScheduler(UWorld * world_in)
+	: world(world_in), next_update_idx(0), batch_state(EBatchState::Done), batch_frame(0),
+	budget_available_ms(0.0f), budget_spent_ms(0.0f), budget_unplanned_ms(0.0f)
+{
+	// Paused worlds do not tick the components, so nothing gets queued
+	dispatch_tick.Target = this;
+	dispatch_tick.is_fence = false;
+	// Components tick in TG_DuringPhysics by default, the batch starts once they all queued
+	dispatch_tick.TickGroup = TG_EndPhysics;
+	dispatch_tick.bCanEverTick = true;
+	dispatch_tick.bTickEvenWhenPaused = true;
+	dispatch_tick.RegisterTickFunction(world->PersistentLevel);
+
+	fence_tick.Target = this;
+	fence_tick.is_fence = true;
+	fence_tick.TickGroup = TG_PostPhysics;
+	fence_tick.bCanEverTick = true;
+	fence_tick.bTickEvenWhenPaused = true;
+	fence_tick.RegisterTickFunction(world->PersistentLevel);
+}
+
+FCreatureUpdateScheduler::~FCreatureUpdateScheduler()
+{
+	FTaskGraphInterface::Get().WaitUntilTasksComplete(update_events, ENamedThreads::GameThread);
+
+	dispatch_tick.UnRegisterTickFunction();
+	fence_tick.UnRegisterTickFunction();
+}
+
+void FCreatureUpdateScheduler::OnWorldCleanup(UWorld * world_in, bool session_ended, bool cleanup_resources)
+{
+	FCreatureUpdateScheduler * found_scheduler = nullptr;
+	if (world_schedulers.RemoveAndCopyValue(world_in, found_scheduler))
+	{
+		delete found_scheduler;
+	}
+}
+
+void FCreatureUpdateScheduler::BeginFrame()
+{
+	if (batch_frame != GFrameCounter)
+	{
+		batch_frame = GFrameCounter;
+		batch_state = EBatchState::Queueing;
+		queued_updates.Reset();
+		update_events.Reset();
+		next_update_idx = 0;
+
+		PlanBudget();
+	}
+}
+
+void FCreatureUpdateScheduler::PlanBudget()
+{
+	const float budget_ms = CVarCreatureUpdateBudgetMs.GetValueOnGameThread();
+	if (budget_ms <= 0.0f)
+	{
+		budget_entries.Reset();
+		budget_available_ms = budget_spent_ms = budget_unplanned_ms = 0.0f;
+		return;
+	}
+
+	// Whatever the last frame left unused carries over, up to one extra frame worth of budget
+	budget_available_ms = budget_ms + FMath::Clamp(budget_available_ms - budget_spent_ms, 0.0f, budget_ms);
+	budget_spent_ms = 0.0f;
+
+	for (auto it = budget_entries.CreateIterator(); it; ++it)
+	{
+		it.Value().granted = false;
+		if (!it.Key().IsValid() || (it.Value().last_request_frame + CREATURE_BUDGET_STALE_FRAMES < batch_frame))
+		{
+			it.RemoveCurrent();
+		}
+	}
+
+	ranked_entries.Reset();
+	for (auto& cur_pair : budget_entries)
+	{
+		if (cur_pair.Value.last_request_frame + 1 == batch_frame)
+		{
+			ranked_entries.Add(&cur_pair.Value);
+		}
+	}
+
+	// Creatures that waited too long go first, the rest by significance that grows with every skipped frame
+	ranked_entries.Sort([](const FBudgetEntry& a, const FBudgetEntry& b) {
+		const bool a_forced = a.frames_skipped >= a.max_skip_frames;
+		const bool b_forced = b.frames_skipped >= b.max_skip_frames;
+		if (a_forced != b_forced)
+		{
+			return a_forced;
+		}
+
+		return a.significance * (a.frames_skipped + 1) > b.significance * (b.frames_skipped + 1);
+	});
+
+	// Cheaper creatures further down still fit into what the expensive ones left over
+	float remaining_ms = budget_available_ms;
+	bool granted_any = false;
+	for (FBudgetEntry * cur_entry : ranked_entries)
+	{
+		if (!granted_any || (cur_entry->cost_ms <= remaining_ms) || (cur_entry->frames_skipped >= cur_entry->max_skip_frames))
+		{
+			cur_entry->granted = true;
+			remaining_ms -= cur_entry->cost_ms;
+			granted_any = true;
+		}
+	}
+
+	budget_unplanned_ms = FMath::Max(remaining_ms, 0.0f);
+}
+
+bool FCreatureUpdateScheduler::RequestFullUpdate(UCreatureMeshComponent * component_in, float significance, int32 max_skip_frames)
+{
+	check(IsInGameThread());
+
+	BeginFrame();
+
+	if (!IsBudgetEnabled())
+	{
+		return true;
+	}
+
+	FBudgetEntry * cur_entry = budget_entries.Find(component_in);
+	if (cur_entry == nullptr)
+	{
+		cur_entry = &budget_entries.Add(component_in);
+		cur_entry->cost_ms = 0.0f;
+		cur_entry->frames_skipped = 0;
+		cur_entry->last_request_frame = 0;
+		cur_entry->granted = false;
+	}
+	else if (cur_entry->last_request_frame == batch_frame)
+	{
+		return cur_entry->granted;
+	}
+
+	const bool was_planned = (cur_entry->last_request_frame + 1 == batch_frame);
+	cur_entry->significance = significance;
+	cur_entry->max_skip_frames = FMath::Max(max_skip_frames, 0);
+	cur_entry->last_request_frame = batch_frame;
+
+	if (!was_planned)
+	{
+		// Not ranked for this frame, so it gets what the plan left over
+		cur_entry->granted = (cur_entry->cost_ms <= budget_unplanned_ms) || (cur_entry->frames_skipped >= cur_entry->max_skip_frames);
+		if (cur_entry->granted)
+		{
+			budget_unplanned_ms = FMath::Max(budget_unplanned_ms - cur_entry->cost_ms, 0.0f);
+		}
+	}
+
+	cur_entry->frames_skipped = cur_entry->granted ? 0 : (cur_entry->frames_skipped + 1);
+
+	return cur_entry->granted;
+}
+
+bool FCreatureUpdateScheduler::IsBudgetEnabled()
+{
+	return CVarCreatureUpdateBudgetMs.GetValueOnGameThread() > 0.0f;
+}
+
+void FCreatureUpdateScheduler::RecordUpdateCost(UCreatureMeshComponent * component_in, float cost_ms)
+{
+	budget_spent_ms += cost_ms;
+
+	FBudgetEntry * cur_entry = budget_entries.Find(component_in);
+	if (cur_entry)
+	{
+		cur_entry->cost_ms = cost_ms;
+	}
+}
+
+void FCreatureUpdateScheduler::RemoveComponent(UCreatureMeshComponent * component_in)
+{
+	check(IsInGameThread());
+
+	budget_entries.Remove(component_in);
+
+	for (auto& cur_update : queued_updates)
+	{
+		if (cur_update.component == component_in)
+		{
+			// Workers may be updating the component right now
+			if (batch_state == EBatchState::Running)
+			{
+				WaitForUpdates();
+			}
+
+			cur_update.component = nullptr;
+		}
+	}
+}
+
+void FCreatureUpdateScheduler::QueueUpdate(UCreatureMeshComponent * component_in, float delta_time)
+{
+	check(IsInGameThread());
+
+	BeginFrame();
+
+	if (batch_state != EBatchState::Queueing)
+	{
+		// The batch is already running or done for this frame, the component ticks too late to be part of it
+		SCOPE_CYCLE_COUNTER(STAT_CreatureScheduler_LateUpdate);
+		INC_DWORD_STAT(STAT_CreatureScheduler_LateUpdates);
+
+		const double start_time = FPlatformTime::Seconds();
+		component_in->ProcessCreatureCoreResult(component_in->RunTickProcessing(delta_time, false));
+		RecordUpdateCost(component_in, (FPlatformTime::Seconds() - start_time) * 1000.0);
+		return;
+	}
+
+	FQueuedUpdate new_update;
+	new_update.component = component_in;
+	new_update.delta_time = delta_time;
+	new_update.cost = 0;
+	new_update.update_ms = 0.0f;
+	new_update.result = false;
+
+	auto cur_manager = component_in->GetCore().GetCreatureManager();
+	if (cur_manager && cur_manager->GetCreature())
+	{
+		new_update.cost = cur_manager->GetCreature()->GetTotalNumPoints();
+	}
+
+	queued_updates.Add(new_update);
+}
+
+void FCreatureUpdateScheduler::Dispatch()
+{
+	BeginFrame();
+	batch_state = EBatchState::Running;
+
+	// Components unregistered or destroyed since they queued their update are dropped
+	queued_updates.RemoveAll([](const FQueuedUpdate& cur_update) {
+		return (cur_update.component == nullptr) || cur_update.component->IsPendingKill();
+	});
+
+	if (queued_updates.Num() == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_CreatureScheduler_Dispatch);
+
+	// Largest first, so the small ones fill in the gaps at the end
+	queued_updates.Sort([](const FQueuedUpdate& a, const FQueuedUpdate& b) {
+		return a.cost > b.cost;
+	});
+
+	mesh_pose_idle_workers = 0;
+
+	int32 num_tasks = FMath::Min(FTaskGraphInterface::Get().GetNumWorkerThreads(), queued_updates.Num());
+	for (int32 i = 0; i < num_tasks; i++)
+	{
+		update_events.Add(FFunctionGraphTask::CreateAndDispatchWhenReady([this]()
+		{
+			RunQueuedUpdates();
+		}, TStatId(), nullptr, ENamedThreads::AnyThread));
+	}
+}
+
+void FCreatureUpdateScheduler::RunQueuedUpdates()
+{
+	SCOPE_CYCLE_COUNTER(STAT_CreatureScheduler_RunUpdates);
+
+	while (true)
+	{
+		int32 cur_idx = FPlatformAtomics::InterlockedIncrement(&next_update_idx) - 1;
+		if (cur_idx >= queued_updates.Num())
+		{
+			// Creatures still posing can hand their chunks to this worker from now on
+			if (!IsInGameThread())
+			{
+				FPlatformAtomics::InterlockedIncrement(&mesh_pose_idle_workers);
+			}
+
+			break;
+		}
+
+		FQueuedUpdate& cur_update = queued_updates[cur_idx];
+		if ((cur_update.component == nullptr) || cur_update.component->IsPendingKill())
+		{
+			continue;
+		}
+
+		const double start_time = FPlatformTime::Seconds();
+		cur_update.result = cur_update.component->RunTickProcessing(cur_update.delta_time, false);
+		cur_update.update_ms = (FPlatformTime::Seconds() - start_time) * 1000.0;
+	}
+}
+
+void FCreatureUpdateScheduler::WaitAndProcessResults()
+{
+	BeginFrame();
+	if (batch_state == EBatchState::Done)
+	{
+		return;
+	}
+
+	WaitForUpdates();
+
+	batch_state = EBatchState::Done;
+
+	for (auto& cur_update : queued_updates)
+	{
+		if (cur_update.component && !cur_update.component->IsPendingKill())
+		{
+			const double start_time = FPlatformTime::Seconds();
+			cur_update.component->ProcessCreatureCoreResult(cur_update.result);
+			RecordUpdateCost(cur_update.component, cur_update.update_ms + (FPlatformTime::Seconds() - start_time) * 1000.0);
+		}
+	}
+
+	queued_updates.Reset();
+}
+
+void FCreatureUpdateScheduler::WaitForUpdates()
+{
+	SCOPE_CYCLE_COUNTER(STAT_CreatureScheduler_Wait);
+
+	RunQueuedUpdates();
+	FTaskGraphInterface::Get().WaitUntilTasksComplete(update_events, ENamedThreads::GameThread);
+	update_events.Reset();
+	mesh_pose_idle_workers = 0;
+}
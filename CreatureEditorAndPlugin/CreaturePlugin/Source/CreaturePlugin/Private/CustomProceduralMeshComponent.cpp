@@ -15,6 +15,7 @@ DECLARE_CYCLE_STAT(TEXT("ProceduralMeshSceneProxy_SetDynamicData"), STAT_Procedu
 DECLARE_CYCLE_STAT(TEXT("Creature CreateDirectVertexData"), STAT_CreateDirectVertexData, STATGROUP_Creature);
 DECLARE_CYCLE_STAT(TEXT("Creature UpdateDirectVertexData"), STAT_UpdateDirectVertexData, STATGROUP_Creature);
 DECLARE_CYCLE_STAT(TEXT("Creature UpdateDirectIndexData"), STAT_UpdateDirectIndexData, STATGROUP_Creature);
+DECLARE_CYCLE_STAT(TEXT("Creature UpdateDirectAttributeData"), STAT_UpdateDirectAttributeData, STATGROUP_Creature);
 
 static TAutoConsoleVariable<int32> CVarShowCreatureMeshes(
 	TEXT("creature.ShowMeshes"),
@@ -24,47 +25,116 @@ static TAutoConsoleVariable<int32> CVarShowCreatureMeshes(
 	TEXT("1: rendered"),
 	ECVF_RenderThreadSafe);
 
+/** Vertex tangent basis, kept in its own stream since it is usually baked once */
+struct FCreatureMeshTangentVertex
+{
+	FPackedNormal TangentX;
+	FPackedNormal TangentZ;
+
+	void SetTangents(const FVector& InTangentX, const FVector& InTangentY, const FVector& InTangentZ)
+	{
+		TangentX = InTangentX;
+		TangentZ = InTangentZ;
+		// store determinant of basis in w component of normal vector
+		TangentZ.Vector.W = GetBasisDeterminantSign(InTangentX, InTangentY, InTangentZ) < 0.0f ? 0 : 255;
+	}
+};
+
+/** Vertex data that only changes on uv warps/swaps or opacity changes */
+struct FCreatureMeshAttributeVertex
+{
+	FVector2D TextureCoordinate;
+	FColor Color;
+};
+
 /** Vertex Buffer */
-class FProceduralMeshVertexBuffer : public FVertexBuffer
+template<typename VertexType>
+class TProceduralMeshVertexBuffer : public FVertexBuffer
 {
 public:
-	TArray<FDynamicMeshVertex> Vertices;
+	TProceduralMeshVertexBuffer(uint32 UsageIn)
+		: Usage(UsageIn)
+	{
+	}
+
+	TArray<VertexType> Vertices;
+	uint32 Usage;
 
 	virtual void InitRHI() override
 	{
 		FRHIResourceCreateInfo CreateInfo;
-		VertexBufferRHI = RHICreateVertexBuffer(Vertices.Num() * sizeof(FDynamicMeshVertex), BUF_Static, CreateInfo);
+		VertexBufferRHI = RHICreateVertexBuffer(Vertices.Num() * sizeof(VertexType), Usage, CreateInfo);
 		UpdateRenderData();
 	}
 
 	void UpdateRenderData() const
 	{
 		// Copy the vertex data into the vertex buffer.
-		void* VertexBufferData = RHILockVertexBuffer(VertexBufferRHI, 0, Vertices.Num() * sizeof(FDynamicMeshVertex), RLM_WriteOnly);
-		FMemory::Memcpy(VertexBufferData, Vertices.GetData(), Vertices.Num() * sizeof(FDynamicMeshVertex));
+		void* VertexBufferData = RHILockVertexBuffer(VertexBufferRHI, 0, Vertices.Num() * sizeof(VertexType), RLM_WriteOnly);
+		FMemory::Memcpy(VertexBufferData, Vertices.GetData(), Vertices.Num() * sizeof(VertexType));
 		RHIUnlockVertexBuffer(VertexBufferRHI);
 	}
 
+	void UpdateRenderData(const TArray<VertexType>& VerticesIn) const
+	{
+		void* VertexBufferData = RHILockVertexBuffer(VertexBufferRHI, 0, VerticesIn.Num() * sizeof(VertexType), RLM_WriteOnly);
+		FMemory::Memcpy(VertexBufferData, VerticesIn.GetData(), VerticesIn.Num() * sizeof(VertexType));
+		RHIUnlockVertexBuffer(VertexBufferRHI);
+	}
 };
 
+typedef TProceduralMeshVertexBuffer<FVector> FProceduralMeshPositionVertexBuffer;
+typedef TProceduralMeshVertexBuffer<FCreatureMeshTangentVertex> FProceduralMeshTangentVertexBuffer;
+typedef TProceduralMeshVertexBuffer<FCreatureMeshAttributeVertex> FProceduralMeshAttributeVertexBuffer;
+
 /** Index Buffer */
 class FProceduralMeshIndexBuffer : public FIndexBuffer
 {
 public:
+	FProceduralMeshIndexBuffer()
+		: Use16BitIndices(false)
+	{
+	}
+
 	TArray<int32> Indices;
+	// Set for meshes with at most 65536 points, halves the index data uploaded on region order changes
+	bool Use16BitIndices;
+
+	uint32 GetStride() const
+	{
+		return Use16BitIndices ? sizeof(uint16) : sizeof(int32);
+	}
 
 	virtual void InitRHI() override
 	{
 		FRHIResourceCreateInfo CreateInfo;
-		IndexBufferRHI = RHICreateIndexBuffer(sizeof(int32), Indices.Num() * sizeof(int32), BUF_Dynamic, CreateInfo);
+		IndexBufferRHI = RHICreateIndexBuffer(GetStride(), Indices.Num() * GetStride(), BUF_Dynamic, CreateInfo);
 		UpdateRenderData();
 	}
 
 	void UpdateRenderData() const
 	{
-		// Copy the index data into the indices buffer
-		void* Buffer = RHILockIndexBuffer(IndexBufferRHI, 0, Indices.Num() * sizeof(int32), RLM_WriteOnly);
-		FMemory::Memcpy(Buffer, Indices.GetData(), Indices.Num() * sizeof(int32));
+		// Copy the index data into the indices buffer, narrowed down for 16 bit buffers
+		void* Buffer = RHILockIndexBuffer(IndexBufferRHI, 0, Indices.Num() * GetStride(), RLM_WriteOnly);
+		if (Use16BitIndices)
+		{
+			uint16* WriteIndices = (uint16*)Buffer;
+			for (int32 i = 0; i < Indices.Num(); i++)
+			{
+				WriteIndices[i] = (uint16)Indices[i];
+			}
+		}
+		else {
+			FMemory::Memcpy(Buffer, Indices.GetData(), Indices.Num() * sizeof(int32));
+		}
+		RHIUnlockIndexBuffer(IndexBufferRHI);
+	}
+
+	// Uploads only the first NumIndicesIn indices, already in the buffer's index format
+	void UpdateRenderData(const void* IndexDataIn, int32 NumIndicesIn) const
+	{
+		void* Buffer = RHILockIndexBuffer(IndexBufferRHI, 0, NumIndicesIn * GetStride(), RLM_WriteOnly);
+		FMemory::Memcpy(Buffer, IndexDataIn, NumIndicesIn * GetStride());
 		RHIUnlockIndexBuffer(IndexBufferRHI);
 	}
 };
@@ -78,36 +148,60 @@ public:
 	}
 
 	/** Initialization */
-	void Init(const FProceduralMeshVertexBuffer* VertexBuffer)
+	void Init(
+		const FProceduralMeshPositionVertexBuffer* PositionVertexBuffer,
+		const FProceduralMeshTangentVertexBuffer* TangentVertexBuffer,
+		const FProceduralMeshAttributeVertexBuffer* AttributeVertexBuffer)
 	{
 		// Commented out to enable building light of a level (but no backing is done for the procedural mesh itself)
 		//check(!IsInRenderingThread());
 
-		ENQUEUE_UNIQUE_RENDER_COMMAND_TWOPARAMETER(
+		ENQUEUE_UNIQUE_RENDER_COMMAND_FOURPARAMETER(
 			InitProceduralMeshVertexFactory,
 			FProceduralMeshVertexFactory*, VertexFactory, this,
-			const FProceduralMeshVertexBuffer*, VertexBuffer, VertexBuffer,
+			const FProceduralMeshPositionVertexBuffer*, PositionVertexBuffer, PositionVertexBuffer,
+			const FProceduralMeshTangentVertexBuffer*, TangentVertexBuffer, TangentVertexBuffer,
+			const FProceduralMeshAttributeVertexBuffer*, AttributeVertexBuffer, AttributeVertexBuffer,
 		{
 			// Initialize the vertex factory's stream components.
+			// Positions, Tangents and UVs/Colors live in separate streams so only positions get uploaded every frame
 			FDataType NewData;
-			NewData.PositionComponent = STRUCTMEMBER_VERTEXSTREAMCOMPONENT(VertexBuffer,FDynamicMeshVertex,Position,VET_Float3);
+			NewData.PositionComponent = FVertexStreamComponent(PositionVertexBuffer, 0, sizeof(FVector), VET_Float3);
+			NewData.TangentBasisComponents[0] = STRUCTMEMBER_VERTEXSTREAMCOMPONENT(TangentVertexBuffer, FCreatureMeshTangentVertex, TangentX, VET_PackedNormal);
+			NewData.TangentBasisComponents[1] = STRUCTMEMBER_VERTEXSTREAMCOMPONENT(TangentVertexBuffer, FCreatureMeshTangentVertex, TangentZ, VET_PackedNormal);
 			NewData.TextureCoordinates.Add(
-				FVertexStreamComponent(VertexBuffer,STRUCT_OFFSET(FDynamicMeshVertex,TextureCoordinate),sizeof(FDynamicMeshVertex),VET_Float2)
+				FVertexStreamComponent(AttributeVertexBuffer,STRUCT_OFFSET(FCreatureMeshAttributeVertex,TextureCoordinate),sizeof(FCreatureMeshAttributeVertex),VET_Float2)
 				);
-			NewData.TangentBasisComponents[0] = STRUCTMEMBER_VERTEXSTREAMCOMPONENT(VertexBuffer,FDynamicMeshVertex,TangentX,VET_PackedNormal);
-			NewData.TangentBasisComponents[1] = STRUCTMEMBER_VERTEXSTREAMCOMPONENT(VertexBuffer,FDynamicMeshVertex,TangentZ,VET_PackedNormal);
-			NewData.ColorComponent = STRUCTMEMBER_VERTEXSTREAMCOMPONENT(VertexBuffer, FDynamicMeshVertex, Color, VET_Color);
+			NewData.ColorComponent = STRUCTMEMBER_VERTEXSTREAMCOMPONENT(AttributeVertexBuffer, FCreatureMeshAttributeVertex, Color, VET_Color);
 			VertexFactory->SetData(NewData);
 		});
 	}
 };
 
+/** Index data handed over to the render thread */
+struct FCreatureMeshIndexFrame
+{
+	FCreatureMeshIndexFrame()
+		: RealNum(INDEX_NONE)
+	{
+	}
+
+	// Only one of these is filled, depending on the index format of the packet
+	TArray<int32> Indices;
+	TArray<uint16> Indices16;
+	int32 RealNum;
+};
+
 /** Mesh Render Packet**/
 class FProceduralMeshRenderPacket
 {
 public:
-	FProceduralMeshRenderPacket(FProceduralMeshTriData * data_in)
+	FProceduralMeshRenderPacket(FProceduralMeshTriData * data_in, ECreatureMeshTangentMode tangent_mode_in)
+		: VertexBuffer(BUF_Dynamic),
+		TangentVertexBuffer((tangent_mode_in == ECreatureMeshTangentMode::Lit) ? BUF_Dynamic : BUF_Static),
+		AttributeVertexBuffer(BUF_Static)
 	{
+		tangent_mode = tangent_mode_in;
 		indices = data_in->indices;
 		points = data_in->points;
 		uvs = data_in->uvs;
@@ -116,16 +210,21 @@ public:
 		real_indices_num = indices_num;
 		region_alphas = data_in->region_alphas;
 		update_lock = data_in->update_lock;
+		staging_points = data_in->staging_points;
 		should_release = false;
+		compute_vertex_tangents = false;
+		IndexBuffer.Use16BitIndices = (point_num <= (MAX_uint16 + 1));
 
 		// ensure the vertex data to be sent to the RHI is initialized
-		CreateDirectVertexData();
+		CreateDirectVertexData(true);
 	}
 
 	virtual ~FProceduralMeshRenderPacket()
 	{
 		if (should_release) {
 			VertexBuffer.ReleaseResource();
+			TangentVertexBuffer.ReleaseResource();
+			AttributeVertexBuffer.ReleaseResource();
 			IndexBuffer.ReleaseResource();
 			VertexFactory.ReleaseResource();
 		}
@@ -139,15 +238,36 @@ public:
 	void InitForRender()
 	{
 		BeginInitResource(&VertexBuffer);
+		BeginInitResource(&TangentVertexBuffer);
+		BeginInitResource(&AttributeVertexBuffer);
 		BeginInitResource(&IndexBuffer);
 		BeginInitResource(&VertexFactory);
 
 		should_release = true;
 	}
 
-	TArray<FDynamicMeshVertex> VertexCache;
+	// Baked tangent frame, also the initial contents of the tangent stream
+	TArray<FCreatureMeshTangentVertex> TangentCache;
 
-	void CreateDirectVertexData()
+	// Game side writes, the render thread uploads whatever was published last without taking the update lock
+	TCreatureRenderTripleBuffer<TArray<FVector>> PositionFrames;
+	TCreatureRenderTripleBuffer<TArray<FCreatureMeshTangentVertex>> TangentFrames;
+	TCreatureRenderTripleBuffer<TArray<FCreatureMeshAttributeVertex>> AttributeFrames;
+	TCreatureRenderTripleBuffer<FCreatureMeshIndexFrame> IndexFrames;
+
+	// Vertex positions, either posed straight into the staging points or swizzled into PositionFrames
+	TCreatureRenderTripleBuffer<TArray<FVector>>& GetPositionFrames()
+	{
+		return staging_points.IsValid() ? *staging_points : PositionFrames;
+	}
+
+	// Last published vertex positions, only for use on the game side
+	const TArray<FVector>& GetPositions() const
+	{
+		return staging_points.IsValid() ? staging_points->GetLastPublished() : PositionFrames.GetLastPublished();
+	}
+
+	void CreateDirectVertexData(bool update_attributes)
 	{
 		SCOPE_CYCLE_COUNTER(STAT_CreateDirectVertexData);
 
@@ -155,96 +275,234 @@ public:
 		const int y_id = 2;
 		const int z_id = 1;
 
+		// Only guards the source data against other game side writers, the render thread never takes this lock
 		FScopeLock scope_lock(update_lock.Get());
 		
-		if (VertexCache.Num() != point_num)
+		bool cache_resized = false;
+		if (TangentCache.Num() != point_num)
 		{
-			VertexCache.Reset(point_num);
-			VertexCache.AddUninitialized(point_num);
+			TangentCache.Reset(point_num);
+			TangentCache.AddUninitialized(point_num);
+			cache_resized = true;
 		}
 
+		if (!staging_points.IsValid())
+		{
+			TArray<FVector>& write_positions = PositionFrames.GetWriteBuffer();
+			if (write_positions.Num() != point_num)
+			{
+				write_positions.Reset(point_num);
+				write_positions.AddUninitialized(point_num);
+			}
+
 #ifdef CREATURE_MULTICORE
-		ParallelFor(this->point_num, [&](int32 i) {
+			ParallelFor(this->point_num, [&](int32 i) {
 #else
-		for (int32 i = 0; i < this->point_num; i++) {
+			for (int32 i = 0; i < this->point_num; i++) {
+#endif
+				int pos_idx = i * 3;
+				write_positions[i] = FVector(this->points[pos_idx + x_id],
+					this->points[pos_idx + y_id],
+					this->points[pos_idx + z_id]);
+#ifdef CREATURE_MULTICORE
+			}, meshPoseSingleThreaded());
+#else
+			}
 #endif
-			FDynamicMeshVertex& curVert = VertexCache[i];
 
-			int pos_idx = i * 3;
-			curVert.Position = FVector(this->points[pos_idx + x_id],
-				this->points[pos_idx + y_id],
-				this->points[pos_idx + z_id]);
+			PositionFrames.Publish();
+		}
 
-			float set_alpha = (*this->region_alphas)[i];
-			curVert.Color = FColor(set_alpha, set_alpha, set_alpha, set_alpha);
+		if (update_attributes || cache_resized)
+		{
+			TArray<FCreatureMeshAttributeVertex>& write_attributes = AttributeFrames.GetWriteBuffer();
+			write_attributes.SetNumUninitialized(point_num);
+			for (int32 i = 0; i < this->point_num; i++)
+			{
+				FCreatureMeshAttributeVertex& curVert = write_attributes[i];
 
-			int uv_idx = i * 2;
-			curVert.TextureCoordinate.Set(this->uvs[uv_idx], this->uvs[uv_idx + 1]);
-#ifdef CREATURE_MULTICORE
-		});
-#else
+				float set_alpha = (*this->region_alphas)[i];
+				curVert.Color = FColor(set_alpha, set_alpha, set_alpha, set_alpha);
+
+				int uv_idx = i * 2;
+				curVert.TextureCoordinate.Set(this->uvs[uv_idx], this->uvs[uv_idx + 1]);
+			}
+
+			AttributeFrames.Publish();
 		}
-#endif
 
-		// Set Tangents
+		// Tangents are only touched when they can change
+		if (compute_vertex_tangents)
+		{
+			ComputeVertexTangents();
+		}
+		else if (cache_resized)
+		{
+			BakeStaticTangents();
+		}
+	}
+
+	void CreateDirectIndexData(int32 real_num_in)
+	{
+		FScopeLock scope_lock(update_lock.Get());
+
+		const int32 real_num = (real_num_in > 0) ? real_num_in : indices_num;
+		FCreatureMeshIndexFrame& write_frame = IndexFrames.GetWriteBuffer();
+		const FCreatureMeshIndexFrame& last_frame = IndexFrames.GetLastPublished();
+		bool indices_changed = (last_frame.RealNum != real_num);
+
+		if (IndexBuffer.Use16BitIndices)
+		{
+			write_frame.Indices16.SetNumUninitialized(indices_num);
+			for (int32 i = 0; i < real_num; i++)
+			{
+				write_frame.Indices16[i] = (uint16)indices[i];
+			}
+
+			indices_changed = indices_changed ||
+				(FMemory::Memcmp(write_frame.Indices16.GetData(), last_frame.Indices16.GetData(), real_num * sizeof(uint16)) != 0);
+		}
+		else {
+			write_frame.Indices.SetNumUninitialized(indices_num);
+			FMemory::Memcpy(write_frame.Indices.GetData(), indices, real_num * sizeof(int32));
+
+			indices_changed = indices_changed ||
+				(FMemory::Memcmp(write_frame.Indices.GetData(), last_frame.Indices.GetData(), real_num * sizeof(int32)) != 0);
+		}
+
+		// Region ordering hands over indices every update, only upload them if the draw order actually changed
+		if (indices_changed)
+		{
+			write_frame.RealNum = real_num;
+			IndexFrames.Publish();
+		}
+	}
+
+	// Bakes one tangent frame for the whole mesh from the current (rest) positions
+	void BakeStaticTangents()
+	{
+		const TArray<FVector>& Positions = GetPositions();
+		FVector NormalSum(0, 0, 0);
+		for (int32 cur_indice = 0; cur_indice < indices_num; cur_indice += 3)
+		{
+			const FVector& pos0 = Positions[indices[cur_indice]];
+			const FVector& pos1 = Positions[indices[cur_indice + 1]];
+			const FVector& pos2 = Positions[indices[cur_indice + 2]];
+
+			NormalSum += (pos2 - pos0) ^ (pos1 - pos0);
+		}
+
+		const FVector TangentZ = NormalSum.IsNearlyZero() ? FVector(0, 1, 0) : NormalSum.GetSafeNormal();
+		FVector TangentX = FVector(1, 0, 0) - TangentZ * (FVector(1, 0, 0) | TangentZ);
+		TangentX = TangentX.IsNearlyZero() ? FVector(0, 0, 1) : TangentX.GetSafeNormal();
+		const FVector TangentY = (TangentX ^ TangentZ).GetSafeNormal();
+
+		for (int32 i = 0; i < point_num; i++)
+		{
+			TangentCache[i].SetTangents(TangentX, TangentY, TangentZ);
+		}
+	}
+
+	// Per-vertex tangents, accumulated per triangle first so shared vertices are never written concurrently
+	void ComputeVertexTangents()
+	{
+		TangentXSums.Reset(point_num);
+		TangentXSums.AddZeroed(point_num);
+		TangentZSums.Reset(point_num);
+		TangentZSums.AddZeroed(point_num);
+
+		const TArray<FVector>& Positions = GetPositions();
+		for (int32 cur_indice = 0; cur_indice < indices_num; cur_indice += 3)
+		{
+			const int32 idx0 = indices[cur_indice];
+			const int32 idx1 = indices[cur_indice + 1];
+			const int32 idx2 = indices[cur_indice + 2];
+
+			const FVector Edge01 = (Positions[idx1] - Positions[idx0]);
+			const FVector Edge02 = (Positions[idx2] - Positions[idx0]);
+			const FVector FaceNormal = (Edge02 ^ Edge01);
+
+			TangentXSums[idx0] += Edge01;
+			TangentXSums[idx1] += Edge01;
+			TangentXSums[idx2] += Edge01;
+			TangentZSums[idx0] += FaceNormal;
+			TangentZSums[idx1] += FaceNormal;
+			TangentZSums[idx2] += FaceNormal;
+		}
+
+		TArray<FCreatureMeshTangentVertex>& write_tangents = TangentFrames.GetWriteBuffer();
+		write_tangents.SetNumUninitialized(point_num);
+
 #ifdef CREATURE_MULTICORE
-		ParallelFor(indices_num / 3, [&](int32 ref_idx) {
-			int32 cur_indice = ref_idx * 3;
+		ParallelFor(this->point_num, [&](int32 i) {
 #else
-		for (int32 cur_indice = 0; cur_indice < indices_num; cur_indice += 3) {
+		for (int32 i = 0; i < this->point_num; i++) {
 #endif
-			FDynamicMeshVertex & vert0 = VertexCache[(indices[cur_indice])];
-			FDynamicMeshVertex & vert1 = VertexCache[(indices[cur_indice + 1])];
-			FDynamicMeshVertex & vert2 = VertexCache[(indices[cur_indice + 2])];
-
-			const FVector Edge01 = (vert1.Position - vert0.Position);
-			const FVector Edge02 = (vert2.Position - vert0.Position);
-
-			const FVector TangentX = Edge01.GetSafeNormal();
-			const FVector TangentZ = (Edge02 ^ Edge01).GetSafeNormal();
+			const FVector TangentZ = TangentZSums[i].GetSafeNormal();
+			FVector TangentX = TangentXSums[i] - TangentZ * (TangentXSums[i] | TangentZ);
+			TangentX = TangentX.GetSafeNormal();
 			const FVector TangentY = (TangentX ^ TangentZ).GetSafeNormal();
 
-			vert0.SetTangents(TangentX, TangentY, TangentZ);
-			vert1.SetTangents(TangentX, TangentY, TangentZ);
-			vert2.SetTangents(TangentX, TangentY, TangentZ);
+			write_tangents[i].SetTangents(TangentX, TangentY, TangentZ);
 #ifdef CREATURE_MULTICORE
-		});
+		}, meshPoseSingleThreaded());
 #else
 		}
 #endif
 
+		TangentFrames.Publish();
 	}
 
-	void UpdateDirectVertexData() const
+	void UpdateDirectVertexData()
 	{
 		SCOPE_CYCLE_COUNTER(STAT_UpdateDirectVertexData);
-		
-		int32 numReadyVertices = VertexCache.Num();
-		check(numReadyVertices == point_num);
 
-		FDynamicMeshVertex* VertexBufferData = (FDynamicMeshVertex *)RHILockVertexBuffer(VertexBuffer.VertexBufferRHI, 0, numReadyVertices * sizeof(FDynamicMeshVertex), RLM_WriteOnly);
+		auto& position_frames = GetPositionFrames();
+		if (position_frames.AcquireLatest())
+		{
+			check(position_frames.GetReadBuffer().Num() == point_num);
+			VertexBuffer.UpdateRenderData(position_frames.GetReadBuffer());
+		}
 
+		if (TangentFrames.AcquireLatest())
 		{
-			FScopeLock scope_lock(update_lock.Get());
-			FMemory::Memcpy(VertexBufferData, &VertexCache[0], numReadyVertices * sizeof(FDynamicMeshVertex));
+			check(TangentFrames.GetReadBuffer().Num() == point_num);
+			TangentVertexBuffer.UpdateRenderData(TangentFrames.GetReadBuffer());
 		}
+	}
+
+	void UpdateDirectAttributeData()
+	{
+		SCOPE_CYCLE_COUNTER(STAT_UpdateDirectAttributeData);
 
-		RHIUnlockVertexBuffer(VertexBuffer.VertexBufferRHI);
+		if (AttributeFrames.AcquireLatest())
+		{
+			check(AttributeFrames.GetReadBuffer().Num() == point_num);
+			AttributeVertexBuffer.UpdateRenderData(AttributeFrames.GetReadBuffer());
+		}
 	}
 
-	void UpdateDirectIndexData() const
+	void UpdateDirectIndexData()
 	{
 		SCOPE_CYCLE_COUNTER(STAT_UpdateDirectIndexData);
 
-		FScopeLock scope_lock(update_lock.Get());
-		void* Buffer = RHILockIndexBuffer(IndexBuffer.IndexBufferRHI, 0, indices_num * sizeof(int32), RLM_WriteOnly);
+		if (!IndexFrames.AcquireLatest())
+		{
+			return;
+		}
 
-		FMemory::Memcpy(Buffer, indices, indices_num * sizeof(int32));
+		// Only the indices that get drawn are uploaded
+		const FCreatureMeshIndexFrame& read_frame = IndexFrames.GetReadBuffer();
+		const void* index_data = IndexBuffer.Use16BitIndices ?
+			(const void*)read_frame.Indices16.GetData() : (const void*)read_frame.Indices.GetData();
+		IndexBuffer.UpdateRenderData(index_data, read_frame.RealNum);
 
-		RHIUnlockIndexBuffer(IndexBuffer.IndexBufferRHI);
+		setRealIndicesNum(read_frame.RealNum);
 	}
 
-	FProceduralMeshVertexBuffer VertexBuffer;
+	FProceduralMeshPositionVertexBuffer VertexBuffer;
+	FProceduralMeshTangentVertexBuffer TangentVertexBuffer;
+	FProceduralMeshAttributeVertexBuffer AttributeVertexBuffer;
 	FProceduralMeshIndexBuffer IndexBuffer;
 	FProceduralMeshVertexFactory VertexFactory;
 	glm::uint32 * indices;
@@ -253,7 +511,12 @@ public:
 	int32 point_num, indices_num, real_indices_num;
 	TArray<uint8> * region_alphas;
 	TSharedPtr<FCriticalSection, ESPMode::ThreadSafe> update_lock;
+	FCreatureStagingPointsPtr staging_points;
 	bool should_release;
+	// Tangent mode of the component when the packet was made, the tangent buffer usage depends on it
+	ECreatureMeshTangentMode tangent_mode;
+	bool compute_vertex_tangents;
+	TArray<FVector> TangentXSums, TangentZSums;
 };
 
 /** Scene proxy */
@@ -268,7 +531,9 @@ FCProceduralMeshSceneProxy::FCProceduralMeshSceneProxy(
 	parentComponent = Component;
 	needs_index_updating = false;
 	needs_index_update_num = -1;
+	needs_attribute_refill = false;
 	active_render_packet_idx = INDEX_NONE;
+	material_needs_tangents = false;
 
 	UpdateMaterial();
 
@@ -296,7 +561,7 @@ FCProceduralMeshSceneProxy::GetActiveRenderPacket()
 
 bool FCProceduralMeshSceneProxy::GetDoesActiveRenderPacketHaveVertices() const
 {
-	return renderPackets.IsValidIndex(active_render_packet_idx) && renderPackets[active_render_packet_idx].VertexCache.Num() > 0;
+	return renderPackets.IsValidIndex(active_render_packet_idx) && renderPackets[active_render_packet_idx].GetPositions().Num() > 0;
 }
 
 void FCProceduralMeshSceneProxy::UpdateMaterial()
@@ -308,24 +573,37 @@ void FCProceduralMeshSceneProxy::UpdateMaterial()
 		Material = UMaterial::GetDefaultMaterial(MD_Surface);
 	}
 
+	material_needs_tangents = (Material->GetShadingModel() != MSM_Unlit);
 	needs_material_updating = false;
 }
 
+bool FCProceduralMeshSceneProxy::ShouldComputeVertexTangents(const FProceduralMeshRenderPacket& packet_in) const
+{
+	return (packet_in.tangent_mode == ECreatureMeshTangentMode::Lit) && material_needs_tangents;
+}
+
 void FCProceduralMeshSceneProxy::AddRenderPacket(FProceduralMeshTriData * targetTrisIn, const FColor& startColorIn)
 {
 	FScopeLock packetLock(&renderPacketsCS);
 
-	FProceduralMeshRenderPacket new_packet(targetTrisIn);
+	FProceduralMeshRenderPacket new_packet(targetTrisIn, parentComponent->tangent_mode);
 	renderPackets.Add(new_packet);
 
 	FProceduralMeshRenderPacket& cur_packet = renderPackets[renderPackets.Num() - 1];
+	if (ShouldComputeVertexTangents(cur_packet))
+	{
+		cur_packet.compute_vertex_tangents = true;
+		cur_packet.ComputeVertexTangents();
+	}
 
 	auto& IndexBuffer = cur_packet.IndexBuffer;
 	auto& VertexBuffer = cur_packet.VertexBuffer;
+	auto& TangentVertexBuffer = cur_packet.TangentVertexBuffer;
+	auto& AttributeVertexBuffer = cur_packet.AttributeVertexBuffer;
 	auto& VertexFactory = cur_packet.VertexFactory;
 
 	IndexBuffer.Indices.SetNum(cur_packet.indices_num);
-	VertexBuffer.Vertices.SetNum(cur_packet.point_num);
+	AttributeVertexBuffer.Vertices.SetNum(cur_packet.point_num);
 
 	// Set topology/indices
 	for (int32 i = 0; i < cur_packet.indices_num; i++)
@@ -333,46 +611,21 @@ void FCProceduralMeshSceneProxy::AddRenderPacket(FProceduralMeshTriData * target
 		IndexBuffer.Indices[i] = cur_packet.indices[i];
 	}
 
-	const int x_id = 0;
-	const int y_id = 2;
-	const int z_id = 1;
-
 	// Fill initial points
+	VertexBuffer.Vertices = cur_packet.GetPositions();
 	for (int32 i = 0; i < cur_packet.point_num; i++)
 	{
-		FDynamicMeshVertex Vert0;
-		int pos_idx = i * 3;
-		Vert0.Position = FVector(cur_packet.points[pos_idx + x_id], cur_packet.points[pos_idx + y_id], cur_packet.points[pos_idx + z_id]);
-
-		Vert0.Color = startColorIn;
-		Vert0.SetTangents(FVector(1, 0, 0), FVector(0, 1, 0), FVector(0, 0, 1));
-
+		FCreatureMeshAttributeVertex AttributeVert0;
+		AttributeVert0.Color = startColorIn;
 		int uv_idx = i * 2;
-		Vert0.TextureCoordinate.Set(cur_packet.uvs[uv_idx], cur_packet.uvs[uv_idx + 1]);
-		VertexBuffer.Vertices[i] = Vert0;
+		AttributeVert0.TextureCoordinate.Set(cur_packet.uvs[uv_idx], cur_packet.uvs[uv_idx + 1]);
+		AttributeVertexBuffer.Vertices[i] = AttributeVert0;
 	}
 
-	// Set Initial Rest Tangents
-	for (int cur_indice = 0; cur_indice < cur_packet.indices_num; cur_indice += 3)
-	{
-		FDynamicMeshVertex& vert0 = VertexBuffer.Vertices[cur_packet.indices[cur_indice]];
-		FDynamicMeshVertex& vert1 = VertexBuffer.Vertices[cur_packet.indices[cur_indice + 1]];
-		FDynamicMeshVertex& vert2 = VertexBuffer.Vertices[cur_packet.indices[cur_indice + 2]];
-
-		const FVector Edge01 = (vert1.Position - vert0.Position);
-		const FVector Edge02 = (vert2.Position - vert0.Position);
-
-		const FVector TangentX = Edge01.GetSafeNormal();
-		const FVector TangentZ = (Edge02 ^ Edge01).GetSafeNormal();
-		const FVector TangentY = (TangentX ^ TangentZ).GetSafeNormal();
-
-		vert0.SetTangents(TangentX, TangentY, TangentZ);
-		vert1.SetTangents(TangentX, TangentY, TangentZ);
-		vert2.SetTangents(TangentX, TangentY, TangentZ);
-	}
+	TangentVertexBuffer.Vertices = cur_packet.compute_vertex_tangents ? cur_packet.TangentFrames.GetLastPublished() : cur_packet.TangentCache;
 
 	// Init vertex factory
-	VertexFactory.Init(&VertexBuffer);
+	VertexFactory.Init(&VertexBuffer, &TangentVertexBuffer, &AttributeVertexBuffer);
 
 	// Enqueue initialization of render resource
 	cur_packet.InitForRender();
@@ -394,10 +647,16 @@ void FCProceduralMeshSceneProxy::ResetAllRenderPackets()
 void FCProceduralMeshSceneProxy::SetActiveRenderPacketIdx(int idxIn)
 {
 	FScopeLock packetLock(&renderPacketsCS);
+	if (active_render_packet_idx != idxIn)
+	{
+		// Attributes of the switched to packet may be stale
+		needs_attribute_refill = true;
+	}
+
 	active_render_packet_idx = idxIn;
 }
 
-void FCProceduralMeshSceneProxy::UpdateDynamicComponentData()
+void FCProceduralMeshSceneProxy::UpdateDynamicComponentData(bool update_attributes)
 {
 	if (active_render_packet_idx < 0)
 	{
@@ -412,7 +671,18 @@ void FCProceduralMeshSceneProxy::UpdateDynamicComponentData()
 	FScopeLock packetLock(&renderPacketsCS);
 
 	auto& cur_packet = renderPackets[active_render_packet_idx];
-	cur_packet.CreateDirectVertexData();
+	cur_packet.compute_vertex_tangents = ShouldComputeVertexTangents(cur_packet);
+
+	bool fill_attributes = update_attributes || needs_attribute_refill;
+	cur_packet.CreateDirectVertexData(fill_attributes);
+	needs_attribute_refill = false;
+
+	if (needs_index_updating)
+	{
+		cur_packet.CreateDirectIndexData(needs_index_update_num);
+		needs_index_updating = false;
+		needs_index_update_num = -1;
+	}
 }
 
 void FCProceduralMeshSceneProxy::SetNeedsMaterialUpdate(bool flag_in)
@@ -422,8 +692,12 @@ void FCProceduralMeshSceneProxy::SetNeedsMaterialUpdate(bool flag_in)
 
 void FCProceduralMeshSceneProxy::SetNeedsIndexUpdate(bool flag_in, int32 index_new_num)
 {
-	needs_index_updating = flag_in;
-	needs_index_update_num = index_new_num;
+	// A pending update is only cleared by the render thread, so frames that skip the upload do not drop it
+	if (flag_in)
+	{
+		needs_index_updating = true;
+		needs_index_update_num = index_new_num;
+	}
 }
 
 void FCProceduralMeshSceneProxy::SetDynamicData_RenderThread()
@@ -437,16 +711,11 @@ void FCProceduralMeshSceneProxy::SetDynamicData_RenderThread()
 		return;
 	}
 
+	// Each stream is only uploaded if the game side published new data for it
 	auto& cur_packet = renderPackets[active_render_packet_idx];
-
 	cur_packet.UpdateDirectVertexData();
-	if (needs_index_updating) 
-	{
-		cur_packet.setRealIndicesNum(needs_index_update_num);
-		cur_packet.UpdateDirectIndexData();
-		needs_index_updating = false;
-		needs_index_update_num = -1;
-	}
+	cur_packet.UpdateDirectAttributeData();
+	cur_packet.UpdateDirectIndexData();
 }
 
 void FCProceduralMeshSceneProxy::GetDynamicMeshElements(const TArray<const FSceneView*>& Views,
@@ -571,7 +840,10 @@ UCustomProceduralMeshComponent::UCustomProceduralMeshComponent(const FObjectInit
 	PrimaryComponentTick.bCanEverTick = false;
 	bounds_scale = 1.0f;
 	bounds_offset = FVector(0, 0, 0);
+	pose_bounds.Init();
 	render_proxy_ready = false;
+	attributes_dirty = false;
+	tangent_mode = ECreatureMeshTangentMode::Static;
 	calc_local_vec_min = FVector(FLT_MIN, FLT_MIN, FLT_MIN);
 	calc_local_vec_max = FVector(FLT_MAX, FLT_MAX, FLT_MAX);
 	bWantsInitializeComponent = true;
@@ -612,6 +884,12 @@ void UCustomProceduralMeshComponent::RecreateRenderProxy(bool flag_in)
 	recreate_render_proxy = flag_in;
 }
 
+void UCustomProceduralMeshComponent::MarkAttributesDirty()
+{
+	FScopeLock cur_lock(&local_lock);
+	attributes_dirty = true;
+}
+
 void UCustomProceduralMeshComponent::ForceAnUpdate(int render_packet_idx, bool markDirty /*= true*/)
 {
 	FScopeLock cur_lock(&local_lock);
@@ -635,7 +913,8 @@ void UCustomProceduralMeshComponent::ForceAnUpdate(int render_packet_idx, bool m
 			localRenderProxy->SetActiveRenderPacketIdx(render_packet_idx);
 		}
 
-		localRenderProxy->UpdateDynamicComponentData();
+		localRenderProxy->UpdateDynamicComponentData(attributes_dirty);
+		attributes_dirty = false;
 		ProcessCalcBounds(localRenderProxy);
 
 		if (markDirty)
@@ -690,58 +969,66 @@ void UCustomProceduralMeshComponent::ProcessCalcBounds(FCProceduralMeshSceneProx
 		cur_packet = localRenderProxy->GetActiveRenderPacket();
 		if (cur_packet)
 		{
-			can_calc = (cur_packet->point_num > 0);
+			can_calc = (cur_packet->point_num > 0) && (cur_packet->GetPositions().Num() == cur_packet->point_num);
 		}
 	}
 
+	// Bounds handed over by posing replace the scan over the vertices, they are only used for one update
+	const bool use_pose_bounds = (render_proxy_ready && localRenderProxy && pose_bounds.IsValid);
+
 	const float bounds_max_scalar = 100000.0f;
 	calc_local_vec_min = FVector(-bounds_max_scalar, -bounds_max_scalar, -bounds_max_scalar);
 	calc_local_vec_max = FVector(bounds_max_scalar, bounds_max_scalar, bounds_max_scalar);
 	
 	// Only if have enough triangles
-	if (can_calc)
+	if (use_pose_bounds || can_calc)
 	{
-		const int x_id = 0;
-		const int y_id = 2;
-		const int z_id = 1;
-
-		auto cur_pts = cur_packet->points;
-
-		// Minimum Vector: It's set to the first vertex's position initially (NULL == FVector::ZeroVector might be required and a known vertex vector has intrinsically valid values)
-		FVector vecMin = FVector(cur_pts[x_id], cur_pts[y_id], cur_pts[z_id]);
-		if ( (vecMin.X == FLT_MIN) || (vecMin.Y == FLT_MIN) || (vecMin.Z == FLT_MIN)
-			|| (vecMin.X == FLT_MAX) || (vecMin.Y == FLT_MAX) || (vecMin.Z == FLT_MAX))
+		FVector vecMin, vecMax;
+		FVector vecMidPt(0, 0, 0);
+		if (use_pose_bounds)
 		{
-			vecMin.Set(0, 0, 0);
+			vecMin = pose_bounds.Min;
+			vecMax = pose_bounds.Max;
+			pose_bounds.Init();
 		}
+		else {
+			// Read the swizzled vertex positions, these are valid both when posing into the staging points or not
+			const TArray<FVector>& cur_pts = cur_packet->GetPositions();
+
+			// Minimum Vector: It's set to the first vertex's position initially (NULL == FVector::ZeroVector might be required and a known vertex vector has intrinsically valid values)
+			vecMin = cur_pts[0];
+			if ( (vecMin.X == FLT_MIN) || (vecMin.Y == FLT_MIN) || (vecMin.Z == FLT_MIN)
+				|| (vecMin.X == FLT_MAX) || (vecMin.Y == FLT_MAX) || (vecMin.Z == FLT_MAX))
+			{
+				vecMin.Set(0, 0, 0);
+			}
 
-		// Maximum Vector: It's set to the first vertex's position initially (NULL == FVector::ZeroVector might be required and a known vertex vector has intrinsically valid values)
-		FVector vecMax = vecMin;
+			// Maximum Vector: It's set to the first vertex's position initially (NULL == FVector::ZeroVector might be required and a known vertex vector has intrinsically valid values)
+			vecMax = vecMin;
 
-		// Get maximum and minimum X, Y and Z positions of vectors
-		FVector vecMidPt(0, 0, 0);
-		for (int32 i = 0; i < cur_packet->point_num; i++)
-		{
-			int32 ptIdx = i * 3;
-			auto posX = cur_pts[ptIdx + x_id];
-			auto posY = cur_pts[ptIdx + y_id];
-			auto posZ = cur_pts[ptIdx + z_id];
+			// Get maximum and minimum X, Y and Z positions of vectors
+			for (int32 i = 0; i < cur_packet->point_num; i++)
+			{
+				auto posX = cur_pts[i].X;
+				auto posY = cur_pts[i].Y;
+				auto posZ = cur_pts[i].Z;
 
-			bool not_flt_min = (posX != FLT_MIN) && (posY != FLT_MIN) && (posZ != FLT_MIN);
-			bool not_flt_max = (posX != FLT_MAX) && (posY != FLT_MAX) && (posZ != FLT_MAX);
+				bool not_flt_min = (posX != FLT_MIN) && (posY != FLT_MIN) && (posZ != FLT_MIN);
+				bool not_flt_max = (posX != FLT_MAX) && (posY != FLT_MAX) && (posZ != FLT_MAX);
 
-			if (not_flt_min && not_flt_max) {
-				vecMin.X = (vecMin.X > posX) ? posX : vecMin.X;
+				if (not_flt_min && not_flt_max) {
+					vecMin.X = (vecMin.X > posX) ? posX : vecMin.X;
 
-				vecMin.Y = (vecMin.Y > posY) ? posY : vecMin.Y;
+					vecMin.Y = (vecMin.Y > posY) ? posY : vecMin.Y;
 
-				vecMin.Z = (vecMin.Z > posZ) ? posZ : vecMin.Z;
+					vecMin.Z = (vecMin.Z > posZ) ? posZ : vecMin.Z;
 
-				vecMax.X = (vecMax.X < posX) ? posX : vecMax.X;
+					vecMax.X = (vecMax.X < posX) ? posX : vecMax.X;
 
-				vecMax.Y = (vecMax.Y < posY) ? posY : vecMax.Y;
+					vecMax.Y = (vecMax.Y < posY) ? posY : vecMax.Y;
 
-				vecMax.Z = (vecMax.Z < posZ) ? posZ : vecMax.Z;
+					vecMax.Z = (vecMax.Z < posZ) ? posZ : vecMax.Z;
+				}
 			}
 		}
 
@@ -789,6 +1076,11 @@ void UCustomProceduralMeshComponent::SetBoundsScale(float value_in)
 	bounds_scale = value_in;
 }
 
+void UCustomProceduralMeshComponent::SetPoseBounds(const FBox& bounds_in)
+{
+	pose_bounds = bounds_in;
+}
+
 void UCustomProceduralMeshComponent::SetBoundsOffset(const FVector& offset_in)
 {
 	bounds_offset = offset_in;
@@ -38,6 +38,8 @@
 #include <math.h>
 #include <Runtime/Core/Public/Async/ParallelFor.h>
 
+volatile int32 mesh_pose_idle_workers = 0;
+
 DECLARE_CYCLE_STAT(TEXT("MeshBoneCacheManager_retrieveValuesAtTime"), STAT_MeshBoneCacheManager_retrieveValuesAtTime, STATGROUP_Creature);
 DECLARE_CYCLE_STAT(TEXT("MeshOpacityCacheManager_retrieveValuesAtTime"), STAT_MeshOpacityCacheManager_retrieveValuesAtTime, STATGROUP_Creature);
 
@@ -623,6 +625,7 @@ meshRenderRegion::meshRenderRegion(glm::uint32 * indices_in,
     main_bone = NULL;
     use_dq = true;
     tag_id = -1;
+    max_bone_influences = 0;
 	uv_level = 0;
 	opacity = 100.0f;
     
@@ -757,12 +760,29 @@ meshRenderRegion::initFastNormalWeightMap(const TMap<FName, meshBone *>& bones_m
             }
         }
         
+        // strongest first, so limiting the influences keeps the ones that matter most
+        relevant_array.StableSort([&new_values](int32 a, int32 b) {
+            return new_values[a] > new_values[b];
+        });
+        
         relevant_bones_indices[i] = relevant_array;
     }
     
     fast_normal_weight_map.Empty();
 }
 
+void
+meshRenderRegion::setMaxBoneInfluences(int32 value_in)
+{
+    max_bone_influences = FMath::Max(value_in, 0);
+}
+
+int32
+meshRenderRegion::getMaxBoneInfluences() const
+{
+    return max_bone_influences;
+}
+
 int32 meshRenderRegion::getNumPts() const
 {
     return end_pt_index - start_pt_index + 1;
@@ -953,7 +973,7 @@ meshRenderRegion::runUvWarp()
 		cur_uvs[0] = set_uv.x;
 		cur_uvs[1] = set_uv.y;
 #ifdef CREATURE_MULTICORE
-	});
+	}, meshPoseSingleThreaded());
 #else
     }
 #endif
@@ -1078,7 +1098,7 @@ void meshRenderRegion::poseFinalPts(glm::float32 * output_pts,
             write_pt[1] += post_displacements[i].y;
         }       
 #ifdef CREATURE_MULTICORE
-	});
+	}, meshPoseSingleThreaded());
 #else
     }
 #endif
@@ -1089,13 +1109,13 @@ void meshRenderRegion::poseFinalPts(glm::float32 * output_pts,
     }
 }
 
-void meshRenderRegion::poseFastFinalPts(glm::float32 * output_pts,
+void meshRenderRegion::poseFastFinalPts(const meshPointsSink& output_sink,
 										bool try_local_displacements,
 										bool try_post_displacements,
-										bool try_uv_swap)
+										bool try_uv_swap,
+										meshPointsBounds * bounds_out)
 {
 	glm::float32 * base_read_pt = getRestPts();
-	glm::float32 * base_write_pt = output_pts;
     
     // fill up dqs
     for(auto i = 0; i < fill_dq_array.Num(); i++)
@@ -1103,14 +1123,21 @@ void meshRenderRegion::poseFastFinalPts(glm::float32 * output_pts,
         fill_dq_array[i] = fast_bones_map[i]->getWorldDq();
     }
     
-    // pose points
+    // pose points, each chunk also reduces the bounds of its own points
+    const int32 num_pts = getNumPts();
+    const int32 num_chunks = FMath::DivideAndRoundUp(num_pts, MESH_POSE_CHUNK_SIZE);
+    chunk_bounds.SetNum(num_chunks, false);
+    
 #ifdef CREATURE_MULTICORE
-	ParallelFor(getNumPts(), [&](int32 i) {
+	ParallelFor(num_chunks, [&](int32 chunk_idx) {
 #else
-	for (int32 i = 0; i < getNumPts(); i++) {
+	for (int32 chunk_idx = 0; chunk_idx < num_chunks; chunk_idx++) {
 #endif
+	  meshPointsBounds& cur_bounds = chunk_bounds[chunk_idx];
+	  cur_bounds.reset();
+	  const int32 chunk_end = FMath::Min(num_pts, (chunk_idx + 1) * MESH_POSE_CHUNK_SIZE);
+	  for (int32 i = chunk_idx * MESH_POSE_CHUNK_SIZE; i < chunk_end; i++) {
 		glm::float32 * read_pt = base_read_pt + (i * 3);
-		glm::float32 * write_pt = base_write_pt + (i * 3);
         glm::vec4 cur_rest_pt(read_pt[0], read_pt[1], read_pt[2], 1);
         
         if(use_local_displacements && try_local_displacements) {
@@ -1123,9 +1150,16 @@ void meshRenderRegion::poseFastFinalPts(glm::float32 * output_pts,
         
         const auto& weight_map_vals = reverse_fast_normal_weight_map[i];
         const auto& bone_indices = relevant_bones_indices[i];
+        int32 num_influences = bone_indices.Num();
+        if ((max_bone_influences > 0) && (max_bone_influences < num_influences))
+        {
+            num_influences = max_bone_influences;
+        }
         
-        for(auto j : bone_indices)
+        // dropped influences are made up for by the normalize below
+        for(int32 k = 0; k < num_influences; k++)
         {
+            int32 j = bone_indices[k];
             float cur_im_weight_val = weight_map_vals[j];
             const dualQuat& world_dq = fill_dq_array[j];
             accum_dq.add(world_dq, cur_im_weight_val, cur_im_weight_val);
@@ -1135,21 +1169,29 @@ void meshRenderRegion::poseFastFinalPts(glm::float32 * output_pts,
         accum_dq.normalize();
         final_pt = glm::vec4(accum_dq.transform(glm::vec3(cur_rest_pt)), 1);
         
-        write_pt[0] = final_pt.x;
-        write_pt[1] = final_pt.y;
-        write_pt[2] = 0;
-        
 		if (use_post_displacements && try_post_displacements)
 		{
-            write_pt[0] += post_displacements[i].x;
-            write_pt[1] += post_displacements[i].y;
-        }       
+            final_pt.x += post_displacements[i].x;
+            final_pt.y += post_displacements[i].y;
+        }
+        
+        output_sink.setPt(i, final_pt.x, final_pt.y);
+        cur_bounds.add(final_pt.x, final_pt.y);
+	  }
 #ifdef CREATURE_MULTICORE
-	});
+	}, meshPoseSingleThreaded());
 #else
 	}
 #endif
     
+    if (bounds_out)
+    {
+        for (const auto& cur_bounds : chunk_bounds)
+        {
+            bounds_out->add(cur_bounds);
+        }
+    }
+    
     // uv warping
 	if (use_uv_warp && try_uv_swap) {
         runUvWarp();
@@ -151,6 +151,16 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
 	FTransform GetBluePrintBoneXform_Name(FName name_in, bool world_transform, float position_slide_factor);
 
+	// Blueprint function that returns the index of a bone for GetBluePrintBoneXform_Index, -1 if there is no such bone.
+	// The index stays the same while the character is loaded.
+	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
+	int32 GetBluePrintBoneIndex(FName name_in) const;
+
+	// Blueprint function that returns the transform of a bone like GetBluePrintBoneXform_Name,
+	// given the index from GetBluePrintBoneIndex instead of the name
+	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
+	FTransform GetBluePrintBoneXform_Index(int32 bone_index, bool world_transform, float position_slide_factor);
+
 	// BLueprint function that returns whether a given input point is colliding with any of the bones
 	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
 	bool IsBluePrintBonesCollide(FVector test_point, float bone_size);
@@ -189,11 +199,11 @@ public:
 
 	// Blueprint function that sets up a custom z order for the various regions
 	UFUNCTION(BlueprintCallable, Category = "Components|Creature", meta = (DeprecatedFunction, DeprecationMessage = "Please replace with _Name version of this function to improve performance"))
-	void SetBluePrintRegionCustomOrder(TArray<FString> order_in);
+	void SetBluePrintRegionCustomOrder(const TArray<FString>& order_in);
 
 	// Blueprint function that sets up a custom z order for the various regions
 	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
-	void SetBluePrintRegionCustomOrder_Name(TArray<FName> order_in);
+	void SetBluePrintRegionCustomOrder_Name(const TArray<FName>& order_in);
 
 	// Blueprint function that clears the custom z order for the various regions
 	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Engine.h"
+
+#if !UE_BUILD_SHIPPING
+
+/** Test mode that checks the creature update does not touch the heap, turned on with creature.CheckTickAllocations.
+ *  Turning it on wraps GMalloc with a proxy that counts the allocations of every thread inside one of these scopes.
+ *  A scope that asked to be reported and saw allocations logs how many and fails an ensure when it ends. */
+class CREATUREPLUGIN_API FCreatureScopedAllocationCheck
+{
+public:
+	// Counts the allocations of this thread until the scope ends, only reported if should_report is set
+	FCreatureScopedAllocationCheck(const TCHAR * label_in, bool should_report);
+
+	~FCreatureScopedAllocationCheck();
+
+	// Returns if creature.CheckTickAllocations is set
+	static bool IsEnabled();
+
+	int32 GetNumAllocations() const
+	{
+		return num_allocations;
+	}
+
+protected:
+	const TCHAR * label;
+	bool is_reported;
+	int32 num_allocations;
+	// Counter of the scope this one is nested in, restored when this one ends
+	int32 * outer_counter;
+};
+
+#endif
@@ -6,6 +6,28 @@
 #include "CreatureMeshComponent.h"
 #include "CreatureAnimStateMachine.generated.h"
 
+// A transition of the compiled state machine, its conditions are a range of the compiled condition table
+struct FCreatureCompiledTransition
+{
+	int32 FirstCondition, NumConditions;
+	int32 TargetState;
+	// The first condition is AnimationEnd, so the transition is also taken when the animation of the state ends
+	bool OnAnimationEnd;
+};
+
+// Condition bit index, and the value it needs for the transition to pass
+struct FCreatureCompiledCondition
+{
+	int32 ConditionId;
+	bool Flag;
+};
+
+struct FCreatureCompiledState
+{
+	UCreatureAnimState* SourceState;
+	int32 FirstTransition, NumTransitions;
+};
+
 UCLASS(BlueprintType)
 class CREATUREPLUGIN_API UCreatureAnimStateMachine :
 	public UObject
@@ -29,6 +51,26 @@ public:
 	//ڵ㣬ڴӸStateʼ״̬ת
 	UPROPERTY()
 	UCreatureAnimState* RootState;
+
+	virtual void PostLoad() override;
+
+	// Flattens the states reachable from RootState into dense tables shared by all instances.
+	// Runs on load, and again whenever the editor compiles the graph.
+	void CompileTransitionTable();
+
+	// States by dense id, their transitions and conditions as ranges of the flat tables
+	TArray<FCreatureCompiledState> CompiledStates;
+	TArray<FCreatureCompiledTransition> CompiledTransitions;
+	TArray<FCreatureCompiledCondition> CompiledConditions;
+
+	// Bit index of every condition name used by a transition
+	TMap<FName, int32> ConditionIds;
+
+	// State instances start in, INDEX_NONE if there is none
+	int32 CompiledEntryState;
+
+	// Bumped on every compile, 0 until the first one
+	int32 CompiledSerial;
 	
 
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "CreatureModule.h"
 #include "CreatureAnimStateMachineInstance.generated.h"
 
 UCLASS()
@@ -25,10 +26,10 @@ public:
 	void InitInstance(class UCreatureAnimStateMachine* forStateMachine);
 
 	void SetCurrentState(class UCreatureAnimState *state);
-	class UCreatureAnimState *GetCurrentState() const
-	{
-		return CurrentState;
-	}
+	class UCreatureAnimState *GetCurrentState() const;
+
+	// Takes the first passing transition of the current state if a condition or the state changed since the last check
+	void EvaluatePendingTransitions();
 
 	class UCreatureMeshComponent *GetOwningMeshComponent() const;
 	class UCreatureAnimStateMachine *GetTargetStateMachine() const
@@ -36,13 +37,49 @@ public:
 		return TargetStateMachine;
 	}
 
+	// Poses AnimationName over the animation of the current state on the named layer, restarting the layer.
+	// With MaskBones only those bones are layered, and their children if MaskChildren is set.
+	// Layers are applied in the order they were first set, all in one skinning pass.
+	UFUNCTION(BlueprintCallable, Category = "Creature")
+	void SetLayer(FName LayerName, FName AnimationName, float Weight, bool Additive, const TArray<FName>& MaskBones, bool MaskChildren = true);
+
+	// Fades a layer in or out without restarting it
+	UFUNCTION(BlueprintCallable, Category = "Creature")
+	void SetLayerWeight(FName LayerName, float Weight);
+
+	UFUNCTION(BlueprintCallable, Category = "Creature")
+	void ClearLayer(FName LayerName);
+
 protected:
 
-	TMap<FName, bool> m_currentConditionValues;
+	// Condition values by the bit index compiled into the state machine
+	TBitArray<> m_conditionBits;
+
+	// Condition names by bit index, so the bits can be carried over when the state machine is recompiled
+	TArray<FName> m_conditionNames;
+
+	// Conditions no transition uses, only kept for GetConditionByName
+	TMap<FName, bool> m_unusedConditions;
+
+	// Dense id of the current state in the compiled state machine
+	int32 m_currentStateId;
+
+	// State behind m_currentStateId, found again by it after a recompile
+	TWeakObjectPtr<class UCreatureAnimState> m_currentSourceState;
+
+	// Compile of the state machine the condition bits were sized for
+	int32 m_compiledSerial;
+
+	bool m_needsEvaluation;
+
+	void SetCurrentStateId(int32 stateId);
+
+	// First passing transition target of the current state, INDEX_NONE if none passes
+	int32 FindTransitionTarget() const;
+
+	// Remaps the condition bits and the current state after the editor recompiled the state machine
+	void SyncCompiledTable();
 
-	UPROPERTY(Transient)
-	UCreatureAnimState* CurrentState;
-	
 	UPROPERTY(Transient)
 	UCreatureAnimStateMachine* TargetStateMachine;
 	
@@ -52,5 +89,11 @@ protected:
 	UFUNCTION()
 	void OnAnimEnd(float frame);
 
+	// Hands the layers over to the owning mesh component's creature
+	void PushLayers();
+
+	TArray<FName> m_layerNames;
+	TArray<CreatureModule::CreatureBlendLayer> m_layers;
+
 };
 
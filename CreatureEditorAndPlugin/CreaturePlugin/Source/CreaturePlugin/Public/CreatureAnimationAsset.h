@@ -24,6 +24,14 @@ struct FCreatureAnimationDataCache
 
 	UPROPERTY(VisibleAnywhere, Category = Creature)
 	FName m_animationName;
+
+	/** Creature space bounds of every frame of the clip, posed with displacements and anchor points applied */
+	UPROPERTY()
+	TArray<FBox2D> m_frameBounds;
+
+	/** Creature space bounds of the whole clip */
+	UPROPERTY(VisibleAnywhere, Category = Creature)
+	FBox2D m_clipBounds;
 };
 
 UCLASS()
@@ -76,7 +84,9 @@ public:
 	void PostInitProperties() override;
 	virtual void PostEditUndo() override;
 	
-	void GatherAnimationData();
+	// Rebuilds the data caches of all clips. Exact frame bounds take a full pose of every frame, so they are only
+	// baked on import and save, loading keeps the serialized ones.
+	void GatherAnimationData(bool bake_frame_bounds = true);
 	
 protected:
 	// Denoting creature filename using UE4's asset registry system
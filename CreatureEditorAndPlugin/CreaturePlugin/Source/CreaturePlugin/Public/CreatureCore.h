@@ -73,17 +73,40 @@ public:
 
 	bool GetAndClearShouldAnimEnd();
 
-	void UpdateCreatureRender();
+	// Alphas from a shared pose are used as they are instead of being rebuilt from the region opacities
+	void UpdateCreatureRender(const TArray<uint8> * shared_alphas_in = nullptr);
 
 	bool InitCreatureRender();
 
 	void InitValues();
 
-	void FillBoneData();
+	// Builds the bone lookup after the character is loaded
+	void InitBoneData();
+
+	// Bone data goes out of date with every pose, it is only rebuilt for the bones that get queried
+	void MarkBoneDataDirty();
+
+	// Rebuilds the bone data of every bone that is out of date
+	void FillBoneData() const;
+
+	// Index of the bone in the bone data, INDEX_NONE if there is no such bone. Stays the same while the character is loaded.
+	int32 GetBoneDataIndex(FName name_in) const;
+
+	// Bone data of the current pose, rebuilt first if it is out of date
+	const FCreatureBoneData& GetBoneData(int32 bone_idx) const;
+
+	// World start and end points of a bone in the current pose
+	void GetBonePoints(int32 bone_idx, glm::vec4& start_pt_out, glm::vec4& end_pt_out) const;
 
 	void ParseEvents(float deltaTime);
 
-	void ProcessRenderRegions();
+	void ProcessRenderRegions(const TArray<uint8> * shared_alphas_in = nullptr);
+
+	// Sizes the render staging points and points the CreatureManager's output at them
+	void SetupRenderStaging();
+
+	// Publishes the posed staging points to the render thread and moves posing on to the next write buffer
+	void PublishRenderStaging(bool depths_changed);
 
 	FProceduralMeshTriData GetProcMeshData(EWorldType::Type world_type);
 
@@ -128,6 +151,9 @@ public:
 
 	FTransform GetBluePrintBoneXform(FName name_in, bool world_transform, float position_slide_factor, const FTransform& base_transform) const;
 
+	// Same as GetBluePrintBoneXform without the bone name lookup, bone_idx comes from GetBoneDataIndex
+	FTransform GetBoneXform(int32 bone_idx, bool world_transform, float position_slide_factor, const FTransform& base_transform) const;
+
 	bool IsBluePrintBonesCollide(FVector test_point, float bone_size, const FTransform& base_transform);
 
 	void SetBluePrintAnimationLoop(bool flag_in);
@@ -147,7 +173,7 @@ public:
 
 	void RemoveBluePrintRegionAlpha(FName region_name_in);
 
-	void SetBluePrintRegionCustomOrder(TArray<FName> order_in);
+	void SetBluePrintRegionCustomOrder(const TArray<FName>& order_in);
 
 	void ClearBluePrintRegionCustomOrder();
 
@@ -163,9 +189,16 @@ public:
 
 	bool RunTick(float delta_time);
 
+	// Advances the animation clock and its start/end events like RunTick, but skips posing and the render and bone data updates.
+	// The render points keep showing the last posed frame. Returns false if the clock could not be advanced.
+	bool RunClockTick(float delta_time);
+
 	// Sets the an active animation by name
 	void SetActiveAnimation(const FName& name_in);
 
+	// Layers posed over the active animation, handed to the CreatureManager before the next update
+	void SetBlendLayers(const TArray<CreatureModule::CreatureBlendLayer>& layers_in);
+
 	// Sets the active animation by smoothly blending, factor is a range of ( 0 < factor < 1 )
 	void SetAutoBlendActiveAnimation(const FName& name_in, float factor);
 
@@ -183,6 +216,36 @@ public:
 
 	int32 GetRealTotalIndicesNum() const;
 
+	// Local space bounds of the last pose, reduced by the CreatureManager while posing. Invalid if there are none to use.
+	FBox GetRenderBounds() const;
+
+	// Local space bounds of the current animation time from the bounds baked into the animation asset.
+	// Does not need the points to be posed. Invalid if the playing clips have no baked bounds.
+	FBox GetBakedRenderBounds() const;
+
+	// Converts creature space point bounds into local render space, with room for the region depths
+	FBox MakeRenderBounds(const meshPointsBounds& bounds_in) const;
+
+	// Forces the next RunTick to pose and update the render data even if the pose inputs did not change
+	void InvalidatePoseCache();
+
+	// Collects the inputs of the pose and the render update into key_out, returns false if they can not be collected.
+	// Playback times are quantized to time_step frames, or to a thousandth of a frame if it is 0.
+	bool MakePoseInputKey(CreatureModule::CreaturePoseKey& key_out, float time_step);
+
+	// Collects the inputs of the pose and the render update, returns true if they match the ones of the last update
+	bool UpdatePoseInputKey();
+
+	// Key of the current pose in the FCreaturePoseCache, returns false if the pose can not be shared
+	bool MakeSharedPoseKey(CreatureModule::CreaturePoseKey& key_out);
+
+	// Takes the pose, render data and bone data of the key from the FCreaturePoseCache, returns false if it has none
+	bool ApplySharedPose(const CreatureModule::CreaturePoseKey& key_in);
+
+	// Counts the ticks in a row that played the same animation, returns true once the scratch memory should have
+	// reached its final size. Ticks after that are checked by the creature.CheckTickAllocations test mode.
+	bool UpdateSteadyTickCount();
+
 	std::vector<meshBone *> getAllChildrenWithIgnore(const FName& ignore_name, meshBone * base_bone = nullptr);
 
 	void enableSkinSwap(const FString& swap_name_in, bool active);
@@ -208,7 +271,15 @@ public:
 
 	TSharedPtr<CreatureModule::CreatureManager> creature_manager;
 
-	TArray<FCreatureBoneData> bone_data;
+	// Bone data by bone index, entries are rebuilt on demand so read them through GetBoneData
+	mutable TArray<FCreatureBoneData> bone_data;
+	mutable TBitArray<> bone_data_valid;
+	TArray<meshBone *> bone_data_bones;
+	TMap<FName, int32> bone_data_indices;
+
+	// Bone points of the pose taken from the FCreaturePoseCache, used instead of the bones while use_shared_bone_pts is set
+	TArray<glm::vec4> shared_bone_pts;
+	bool use_shared_bone_pts;
 
 	TArray<uint8> region_alphas;
 
@@ -236,6 +307,43 @@ public:
 
 	bool should_update_render_indices;
 
+	// Set when the uvs or region alphas changed in the last render update
+	bool should_update_render_attributes;
+
+	// Poses straight into render_staging_pts instead of the creature's render points, takes effect when the render data is fetched
+	bool skin_into_render_staging;
+
+	// Bounds of the whole cached clip are used instead of the posed points when point caching is active
+	bool use_clip_bounds;
+
+	// Posing quality handed to the CreatureManager before every update
+	CreatureModule::CreatureLodSettings lod_settings;
+
+	// Blend layers waiting to be handed to the CreatureManager
+	TArray<CreatureModule::CreatureBlendLayer> blend_layers;
+	bool blend_layers_dirty;
+
+	// Takes finished poses from other instances of the same character playing the same clips at about the same time
+	bool use_shared_pose_cache;
+
+	// Playback times closer than this many frames share a pose when use_shared_pose_cache is on
+	float shared_pose_time_step;
+
+	// Set by RunTick when nothing the pose depends on changed, so posing and the render update were skipped
+	// and the render data from the last update is still current
+	bool pose_unchanged;
+
+	// Final swizzled vertex positions handed to the render packet when skin_into_render_staging is on.
+	// Posing writes into the write buffer while the render thread uploads the last published one.
+	// Made anew by every SetupRenderStaging, the render packets of older render data keep their own.
+	FCreatureStagingPointsPtr render_staging_frames;
+
+	// CreatureManager render points serial of the last published staging points
+	int32 render_staging_serial;
+
+	// Per point region depths written during posing, and the depths computed for the current region order
+	TArray<glm::float32> render_pts_z, render_pts_next_z;
+
 	TSharedPtr<FCriticalSection, ESPMode::ThreadSafe> update_lock;
 
 	//////////////////////////////////////////////////////////////////////////
@@ -251,6 +359,24 @@ public:
 	TArray<int32> skin_swap_indices;
 	TSet<int32> skin_swap_region_ids;
 	int32 region_order_indices_num;
+
+	// Region order last copied into global_indices_copy, the copy is only rebuilt when the sampled order changes
+	const TArray<int32> * applied_region_order;
+	const CreatureMetaData * region_order_meta_data;
+	uint32 region_order_meta_serial;
+	bool region_order_applied;
+	TMap<int32, TTuple<int32, int32>> region_order_pt_ranges;
+
+	// Name of the active animation as the meta data expects it, only converted when the animation changes
+	FName meta_animation_name;
+	FString meta_animation_name_string;
+	TArray<uint8> last_region_alphas;
+	bool uvs_animated_last;
+	// Pose inputs of the last and the current update, and the shared pose key. Members, so their memory is reused.
+	CreatureModule::CreaturePoseKey last_pose_key, next_pose_key, shared_pose_key;
+	bool pose_key_valid;
+	FName steady_animation_name;
+	int32 steady_tick_count;
 };
 
 std::string ConvertToString(const FString &str);
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CustomProceduralMeshComponent.h"
+#include "CreatureCrowdComponent.generated.h"
+
+class UCreatureMeshComponent;
+
+// Where one crowd member lives inside the merged crowd buffers
+struct FCreatureCrowdSlot
+{
+	int32 point_offset, point_num;
+	int32 indice_offset, indices_num;
+};
+
+/** Draws many Creature Mesh Components with one render packet and one draw call.
+ *  Every tick the posed points of the added creatures are transformed into the space of this component and appended
+ *  into one shared vertex stream. All creatures are drawn with the material of this component, so they should share
+ *  the same material and texture atlas. Added creatures stop drawing themselves until they are removed again. */
+UCLASS(editinlinenew, meta = (BlueprintSpawnableComponent), ClassGroup=Rendering)
+class CREATUREPLUGIN_API UCreatureCrowdComponent : public UCustomProceduralMeshComponent
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	// Merges the creature into this crowd's draw. Membership changes rebuild the crowd buffers, so batch them up at setup time.
+	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
+	void AddCreature(UCreatureMeshComponent * creature_in);
+
+	// Removes the creature from this crowd, it goes back to drawing itself
+	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
+	void RemoveCreature(UCreatureMeshComponent * creature_in);
+
+	// Returns the number of creatures drawn by this crowd
+	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
+	int32 GetCreatureCount() const;
+
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
+
+	virtual void OnUnregister() override;
+
+protected:
+	UPROPERTY(Transient)
+	TArray<UCreatureMeshComponent *> crowd_creatures;
+
+	TArray<FCreatureCrowdSlot> crowd_slots;
+	TArray<glm::uint32> crowd_indices;
+	TArray<glm::float32> crowd_uvs;
+	TArray<uint8> crowd_alphas;
+	TCreatureRenderTripleBuffer<TArray<FVector>> crowd_points;
+	TSharedPtr<FCriticalSection, ESPMode::ThreadSafe> crowd_lock;
+	bool layout_dirty;
+
+	bool IsCreatureReady(UCreatureMeshComponent * creature_in) const;
+
+	bool HasLayoutChanged() const;
+
+	// Recomputes the slots of all creatures and recreates the render proxy for the new buffer sizes
+	void RebuildLayout();
+
+	// Transforms the posed points of every creature into the crowd buffers, attributes only when they changed or if forced
+	void GatherCreatures(bool force_attributes);
+};
@@ -255,43 +255,60 @@ struct FCreatureRepeatFrameCallback {
 	int32 currentFrame, triggeredFrame, startFrame;
 };
 
-// Blueprint event delegates event declarations
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FCreatureMeshAnimationStartEvent, float, frame);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FCreatureMeshAnimationEndEvent, float, frame);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FCreatureFrameCallbackEvent, FName, name);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FCreatureRepeatFrameCallbackEvent, FName, name);
+// Frame callbacks of one clip by index, the one shot callbacks sorted by frame so a tick only looks at the ones it crossed
+struct FCreatureCallbackTimeline
+{
+	TArray<int32> frame_callback_ids;
+	TArray<int32> repeat_callback_ids;
+};
 
-/**
-* Tick function that processes the results of the creature core update
-**/
+/** Posing quality used while the character is small on screen */
 USTRUCT(BlueprintType)
-struct FCreatureCoreResultTickFunction : public FTickFunction
+struct FCreatureLodLevel
 {
 	GENERATED_USTRUCT_BODY()
 
-	class UCreatureMeshComponent*	Target;
-
-	/**
-	* Abstract function to execute the tick.
-	* @param DeltaTime - frame time to advance, in seconds.
-	* @param TickType - kind of tick for this frame.
-	* @param CurrentThread - thread we are executing on, useful to pass along as new tasks are created.
-	* @param MyCompletionGraphEvent - completion event for this task. Useful for holding the completetion of this task until certain child tasks are complete.
-	*/
-	virtual void ExecuteTick(float DeltaTime, enum ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
-	/** Abstract function to describe this tick. Used to print messages about illegal cycles in the dependency graph. */
-	virtual FString DiagnosticMessage() override;
+	/** This level is used once the character covers less than this fraction of the screen */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature")
+	float screen_size = 0.25f;
+
+	/** Number of the strongest bones that skin each point, 1 is rigid skinning. 0 uses all of them. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature")
+	int32 max_bone_influences = 2;
+
+	/** Bones are only sampled on every this many animation frames */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature")
+	int32 bone_sample_frames = 1;
+
+	/** Skips the mesh deformation displacements of the animation */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature")
+	bool skip_displacements = false;
+
+	/** Skips the UV warps of the animation */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature")
+	bool skip_uv_warps = false;
 };
 
-template<>
-struct TStructOpsTypeTraits<FCreatureCoreResultTickFunction> : public TStructOpsTypeTraitsBase2<FCreatureCoreResultTickFunction>
+/** How the bounding box used for culling is found every update */
+UENUM(BlueprintType)
+enum class ECreatureBoundsMode : uint8
 {
-	enum
-	{
-		WithCopy = false
-	};
+	/** Bounds are reduced while posing, no extra pass over the points */
+	Posed,
+	/** Bounds of the whole cached animation clip, only applies to clips with a point cache. Cheapest but looser. */
+	Clip,
+	/** Scans all the final vertex positions every update */
+	Scan,
+	/** Per-frame bounds baked into the animation asset, known without posing. Falls back to Posed for clips without baked bounds. Does not include bone overrides. */
+	Baked
 };
 
+// Blueprint event delegates event declarations
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FCreatureMeshAnimationStartEvent, float, frame);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FCreatureMeshAnimationEndEvent, float, frame);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FCreatureFrameCallbackEvent, FName, name);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FCreatureRepeatFrameCallbackEvent, FName, name);
+
 
 /** Component that allows you to specify custom triangle mesh geometry */
 //////////////////////////////////////////////////////////////////////////
@@ -392,6 +409,63 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature")
 	bool run_task_multicore;
 
+	// Poses the character straight into the render vertex staging buffer, skipping the intermediate render points copy.
+	// Takes effect the next time the render data is created, does not apply to collection playback.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature")
+	bool skin_into_render_buffer;
+
+	/** How the bounding box of the character is computed every update */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature")
+	ECreatureBoundsMode bounds_mode;
+
+	/** Skips posing the character while it is off-screen and poses it at a reduced rate while it is small on screen.
+	  * The animation clock, start/end events and frame callbacks still run every tick. Use the Baked bounds mode
+	  * so the bounds keep following the animation while posing is skipped. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature|Update Rate")
+	bool enable_update_rate_optimizations;
+
+	/** Number of frames the character has to go unrendered before only its clock is advanced */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature|Update Rate")
+	int32 uro_offscreen_frames;
+
+	/** Fraction of the screen covered by the bounds of the character, below which it is posed at the reduced rate */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature|Update Rate")
+	float uro_small_screen_size;
+
+	/** The character is posed once every this many frames while it is small on screen */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature|Update Rate")
+	int32 uro_small_update_rate;
+
+	/** Gameplay weight of the character when the creature.UpdateBudgetMs frame budget is over-subscribed.
+	  * Characters are ranked by screen size times this value, important characters should use a large value. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature|Update Rate")
+	float budget_priority;
+
+	/** Most frames in a row the frame budget may skip posing the character */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature|Update Rate")
+	int32 budget_max_skip_frames;
+
+	/** Copies the finished pose of another character that plays the same clips at about the same time this frame instead of posing.
+	  * Meant for crowds of identical characters. Characters with blend layers, uv animation or a bones override callback always pose. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature|Update Rate")
+	bool share_poses;
+
+	/** Characters whose playback times are within this many frames of each other share a pose when share_poses is on */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature|Update Rate")
+	float shared_pose_time_step;
+
+	/** Levels of detail picked by the screen size of the character, the smallest matching screen_size wins. Empty poses at full quality. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature|LOD")
+	TArray<FCreatureLodLevel> lod_levels;
+
+	/** Level of detail used by the last update, INDEX_NONE for full quality */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components|Creature|LOD")
+	int32 active_lod_level;
+
+	/** Crowd that draws this creature as part of its own batch, set by UCreatureCrowdComponent::AddCreature. This component does not draw itself while it is set. */
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Components|Creature")
+	class UCreatureCrowdComponent * crowd_owner;
+
 	/** Activates/Deactivates anchor points in the character if it was setup in the Creature Animation Editor */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature")
 	bool use_anchor_points;
@@ -491,6 +565,16 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
 	FTransform GetBluePrintBoneXform_Name(FName name_in, bool world_transform, float position_slide_factor) const;
 
+	// Blueprint function that returns the index of a bone for GetBluePrintBoneXform_Index, -1 if there is no such bone.
+	// The index stays the same while the character is loaded.
+	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
+	int32 GetBluePrintBoneIndex(FName name_in) const;
+
+	// Blueprint function that returns the transform of a bone like GetBluePrintBoneXform_Name,
+	// given the index from GetBluePrintBoneIndex instead of the name
+	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
+	FTransform GetBluePrintBoneXform_Index(int32 bone_index, bool world_transform, float position_slide_factor) const;
+
 	// Blueprint function that decides whether the animation will loop or not
 	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
 	void SetBluePrintAnimationLoop(bool flag_in);
@@ -537,11 +621,11 @@ public:
 
 	// Blueprint function that sets up a custom z order for the various regions
 	UFUNCTION(BlueprintCallable, Category = "Components|Creature", meta=(DeprecatedFunction, DeprecationMessage = "Please replace with _Name version of this function to improve performance"))
-	void SetBluePrintRegionCustomOrder(TArray<FString> order_in);
+	void SetBluePrintRegionCustomOrder(const TArray<FString>& order_in);
 
 	// Blueprint function that sets up a custom z order for the various regions
 	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
-	void SetBluePrintRegionCustomOrder_Name(TArray<FName> order_in);
+	void SetBluePrintRegionCustomOrder_Name(const TArray<FName>& order_in);
 
 	// Blueprint function that clears the custom z order for the various regions
 	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
@@ -650,8 +734,8 @@ public:
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
 
 	virtual void OnRegister() override;
-	virtual void RegisterComponentTickFunctions(bool bRegister) override;
-	void RegisterCoreResultsTickFunction(bool bRegister);
+
+	virtual void OnUnregister() override;
 
 	virtual void InitializeComponent() override;
 
@@ -685,6 +769,14 @@ protected:
 	TMap<FName, std::pair<glm::vec4, glm::vec4> > internal_ik_bone_pts;
 	TArray<FCreatureFrameCallback> frame_callbacks;
 	TArray<FCreatureRepeatFrameCallback> repeat_frame_callbacks;
+
+	// Callbacks grouped by clip, rebuilt the next tick after the callbacks change
+	TMap<FName, FCreatureCallbackTimeline> callback_timelines;
+	bool callback_timelines_dirty;
+	FName callback_timeline_clip;
+	const FCreatureCallbackTimeline * active_callback_timeline;
+	int32 next_frame_callback;
+	int32 last_callback_frame;
 	TSharedPtr<CreaturePhysicsData> physics_data;
 	FString delay_bendphysics_clip;
 
@@ -696,14 +788,34 @@ protected:
 
 	void RunTick(float DeltaTime);
 
+	// Tick used by the update rate optimizations on frames the character is not posed, only moves its clock and events along
+	void RunClockTick(float DeltaTime);
+
+	void RunFrameCallbacks();
+
+	// Decides if this tick poses the character, or just advances its clock
+	bool ShouldRunFullUpdate();
+
+	// Asks the update scheduler if the frame budget leaves room to pose the character this tick
+	bool RequestBudgetedUpdate();
+
+	// Largest fraction of the screen the bounds cover for any of the local player cameras
+	float GetScreenSize() const;
+
+	// Picks the level of detail for the screen size and hands its settings to the core
+	void UpdateLodLevel(float screen_size);
+
+	// Moves the bounds along with the baked animation bounds without posing the character
+	void UpdateBakedBounds();
+
 	void RunCollectionTick(float DeltaTime);
 
 	void FireStartEndEvents();
 
 	bool RunTickProcessing(float DeltaTime, bool markDirty);
 
-	/** Update systems */
-	void ProcessCreatureCoreResult(FCreatureCoreResultTickFunction& ThisTickFunction);
+	/** Hands the result of an update run by the FCreatureUpdateScheduler back to the component */
+	void ProcessCreatureCoreResult(bool can_tick);
 
 	void StandardInit();
 
@@ -732,16 +844,21 @@ protected:
 
 	void ResetFrameCallbacks();
 
+	void BuildCallbackTimelines();
+
 	void ProcessFrameCallbacks();
 
+	// Triggers the callbacks of the active timeline that are due at frame_in
+	void TriggerFrameCallbacks(float frame_in);
+
 	void LoadAnimationFromStore();
 
 	void TryCreateBendPhysics();
 
-	// future used for async creature processing
-	TFuture<bool> creatureTickResult;
+	// update rate optimization state
+	float uro_last_render_time;
+	int32 uro_frames_not_rendered, uro_frames_since_update;
 
-	FCreatureCoreResultTickFunction EndPhysicsTickFunction;
-	friend struct FCreatureCoreResultTickFunction;
+	friend class FCreatureUpdateScheduler;
 
 };
@@ -2,6 +2,7 @@
 #include "Engine.h"
 #include "glm/fwd.hpp"
 #include <vector>
+#include "MeshBone.h"
 #include "CreatureMetaAsset.generated.h"
 
 class meshBone;
@@ -9,12 +10,23 @@ class meshRenderBoneComposition;
 
 class CreatureMetaData {
 public:
+	CreatureMetaData()
+		: serial(MakeSerial())
+	{}
 
 	void clear()
 	{
 		mesh_map.Empty();
 		anim_order_map.Empty();
 		skin_swaps.Empty();
+		serial = MakeSerial();
+	}
+
+	// Changes whenever the meta data is cleared for a rebuild, unique across all meta data.
+	// Users that cache anything derived from it compare this, the address stays the same across a rebuild.
+	uint32 getSerial() const
+	{
+		return serial;
 	}
 
 	void buildSkinSwapIndices(
@@ -24,25 +36,34 @@ public:
 		TSet<int32>& skin_swap_region_ids
 	);
 
+	// Finds the range of points every region's indices refer to, so region depths are written once per point
+	void buildRegionPointRanges(
+		const glm::uint32 * src_indices,
+		int num_indices,
+		TMap<int32, TTuple<int32, int32>>& region_pt_ranges
+	) const;
+
 	bool hasRegionOrder(const FString& anim_name, int time_in)
 	{
 		return (sampleOrder(anim_name, time_in) != nullptr);
 	}
 
+	// Writes the region depths of cur_order and returns the number of indices it draws.
+	// The reordered indices are only copied into dst_indices if write_indices is set, the previous copy is kept otherwise.
 	int updateIndicesAndPoints(
 		glm::uint32 * dst_indices,
 		glm::uint32 * src_indices, 
-		glm::float32 * dst_pts,
+		const meshPointsSink& dst_pts,
 		float delta_z,
 		int num_indices,
 		int num_pts,
-		const FString& anim_name,
+		const TArray<int32> * cur_order,
+		const TMap<int32, TTuple<int32, int32>>& region_pt_ranges,
+		bool write_indices,
 		bool skin_swap_active,
-		const TSet<int32>& skin_swap_region_ids,
-		int time_in)
+		const TSet<int32>& skin_swap_region_ids)
 	{
 		bool has_data = false;
-		auto cur_order = sampleOrder(anim_name, time_in);
 		if(cur_order)
 		{
 			has_data = (cur_order->Num() > 0);
@@ -56,17 +77,21 @@ public:
 			glm::uint32 * write_ptr = dst_indices;
 			for (auto region_id : (*cur_order))
 			{
-				if (mesh_map.Contains(region_id) == false)
+				auto mesh_data = mesh_map.Find(region_id);
+				if (mesh_data == nullptr)
 				{
 					// region not found, just copy and return
-					std::memcpy(dst_indices, src_indices, num_indices * sizeof(glm::uint32));
+					if (write_indices)
+					{
+						std::memcpy(dst_indices, src_indices, num_indices * sizeof(glm::uint32));
+					}
+
 					return num_indices;
 				}
 
 				// Write indices
-				auto& mesh_data = mesh_map[region_id];
-				auto num_write_indices = mesh_data.Get<1>() - mesh_data.Get<0>() + 1;
-				auto region_src_ptr = src_indices + mesh_data.Get<0>();
+				auto num_write_indices = mesh_data->Get<1>() - mesh_data->Get<0>() + 1;
+				auto region_src_ptr = src_indices + mesh_data->Get<0>();
 				bool valid_region = true;
 				if (skin_swap_active)
 				{
@@ -78,25 +103,30 @@ public:
 					if (total_num_write_indices > num_indices)
 					{
 						// overwriting boundaries of array, regions do not match so copy and return
-						std::memcpy(dst_indices, src_indices, num_indices * sizeof(glm::uint32));
+						if (write_indices)
+						{
+							std::memcpy(dst_indices, src_indices, num_indices * sizeof(glm::uint32));
+						}
+
 						return num_indices;
 					}
 
-					std::memcpy(write_ptr, region_src_ptr, num_write_indices * sizeof(glm::uint32));
+					if (write_indices)
+					{
+						std::memcpy(write_ptr, region_src_ptr, num_write_indices * sizeof(glm::uint32));
+					}
+
 					write_ptr += num_write_indices;
 				}
 
 				// Write points
 				{
-					int start_idx = mesh_data.Get<0>();
-					int end_idx = mesh_data.Get<1>();
-					
-					if ((int)src_indices[end_idx] < num_pts)
+					auto pt_range = region_pt_ranges.Find(region_id);
+					if (pt_range && (pt_range->Get<1>() < num_pts))
 					{
-						for (int i = start_idx; i <= end_idx; i++)
+						for (int i = pt_range->Get<0>(); i <= pt_range->Get<1>(); i++)
 						{
-							auto cur_pt_idx = src_indices[i] * 3;
-							dst_pts[cur_pt_idx + 2] = cur_z;
+							dst_pts.setZ(i, cur_z);
 						}
 					}
 
@@ -107,7 +137,11 @@ public:
 		else {
 			// Nothing changded, just copy from source
 			total_num_write_indices = num_indices;
-			std::memcpy(dst_indices, src_indices, num_indices * sizeof(glm::uint32));
+			if (write_indices)
+			{
+				std::memcpy(dst_indices, src_indices, num_indices * sizeof(glm::uint32));
+			}
+
 			return num_indices;
 		}
 
@@ -155,6 +189,11 @@ public:
 	TMap<FString, TMap<int32, TArray<int32> >> anim_order_map;
 	TMap<FString, TMap<int32, FString> > anim_events_map;
 	TMap<FString, TSet<FString>> skin_swaps;
+
+protected:
+	static uint32 MakeSerial();
+
+	uint32 serial;
 };
 
 class CreaturePhysicsData
@@ -98,6 +98,116 @@ namespace CreatureModule {
 		glm::vec2 scale;
 		int32 tag;
 	};
+
+	// Posing quality of a level of detail, the defaults pose at full quality
+	struct CreatureLodSettings {
+		CreatureLodSettings()
+		{
+			max_bone_influences = 0;
+			bone_sample_step = 1;
+			skip_displacements = false;
+			skip_uv_warps = false;
+		}
+
+		bool operator==(const CreatureLodSettings& other) const
+		{
+			return (max_bone_influences == other.max_bone_influences)
+				&& (bone_sample_step == other.bone_sample_step)
+				&& (skip_displacements == other.skip_displacements)
+				&& (skip_uv_warps == other.skip_uv_warps);
+		}
+
+		// Strongest bones skinning each point, 0 uses all of them
+		int32 max_bone_influences;
+		// Bones are sampled on frames that are a multiple of this step
+		int32 bone_sample_step;
+		bool skip_displacements;
+		bool skip_uv_warps;
+	};
+
+	// Everything a pose depends on as a flat list of words, two keys only match if all of their inputs do
+	struct CreaturePoseKey {
+		CreaturePoseKey()
+		{
+			hash = 0;
+		}
+
+		void reset()
+		{
+			words.Reset();
+			hash = 0;
+		}
+
+		void add(uint32 value_in)
+		{
+			words.Add(value_in);
+			hash = HashCombine(hash, value_in);
+		}
+
+		void addFloat(float value_in)
+		{
+			uint32 float_bits;
+			FMemory::Memcpy(&float_bits, &value_in, sizeof(float_bits));
+			add(float_bits);
+		}
+
+		void addName(const FName& name_in)
+		{
+			add((uint32)name_in.GetComparisonIndex());
+			add((uint32)name_in.GetNumber());
+		}
+
+		void addString(const FString& str_in)
+		{
+			add((uint32)str_in.Len());
+			for (int32 i = 0; i < str_in.Len(); i++)
+			{
+				add((uint32)str_in[i]);
+			}
+		}
+
+		bool operator==(const CreaturePoseKey& other) const
+		{
+			return (hash == other.hash) && (words == other.words);
+		}
+
+		TArray<uint32> words;
+		uint32 hash;
+	};
+
+	inline uint32 GetTypeHash(const CreaturePoseKey& key_in)
+	{
+		return key_in.hash;
+	}
+
+	// An animation posed over the base animation in bone space, see CreatureManager::SetBlendLayers
+	struct CreatureBlendLayer {
+		CreatureBlendLayer()
+		{
+			weight = 1.0f;
+			additive = false;
+			loop = true;
+			play_serial = 0;
+			run_time = 0.0f;
+			sampled_time = -1.0f;
+		}
+
+		FName animation_name;
+		// How much of the layer is applied, scaled per bone by bone_mask
+		float weight;
+		// Adds the motion of the layer relative to its first frame instead of replacing the pose
+		bool additive;
+		bool loop;
+		// Per bone weights in the order of the bones map, see CreatureManager::MakeBoneMask. Empty applies to every bone.
+		TArray<float> bone_mask;
+		// Bump to restart the layer from the start of its animation
+		int32 play_serial;
+
+		// Playback state and the last sampled bones, kept by the CreatureManager
+		float run_time;
+		float sampled_time;
+		TArray<glm::vec4> sampled_bone_pts;
+	};
     
     // Class for the creature character
     class Creature {
@@ -211,7 +321,17 @@ namespace CreatureModule {
 
 		void clearCachePts();
         
-        void poseFromCachePts(float time_in, glm::float32 * target_pts, int32 num_pts);
+        void poseFromCachePts(float time_in, const meshPointsSink& target_sink, int32 num_pts,
+                              meshPointsBounds * bounds_out=nullptr);
+
+        // Bounds enclosing every cached frame of this animation, recomputed when the point cache changes
+        const meshPointsBounds& getCacheBounds(int32 num_pts);
+
+        // Bounds of every frame of the animation baked offline, one entry per frame from the start time
+        TArray<meshPointsBounds>& getFrameBounds();
+
+        // Adds the baked bounds of the frames around time_in, returns false if there are no baked bounds
+        bool addFrameBoundsAtTime(float time_in, meshPointsBounds& bounds_out) const;
         
     protected:
         
@@ -227,6 +347,9 @@ namespace CreatureModule {
         meshUVWarpCacheManager uv_warp_cache;
 		meshOpacityCacheManager opacity_cache;
 		TArray<glm::float32 *> cache_pts;
+		meshPointsBounds cache_bounds;
+		int32 cache_bounds_frames;
+		TArray<meshPointsBounds> frame_bounds;
     };
     
     // Class for managing a collection of animations and a creature character
@@ -284,6 +407,9 @@ namespace CreatureModule {
         
         // Runs a single step of the animation for a given delta timestep
         void Update(float delta);
+
+        // Only moves the animation clocks and blend factors forward by a delta timestep, nothing is posed
+        void AdvanceTime(float delta);
         
         // Sets scaling for time
         void SetTimeScale(float scale_in);
@@ -342,6 +468,58 @@ namespace CreatureModule {
         
 		// Just poses the bones of the character
 		void PoseJustBones(const FName& animation_name_in, float input_run_time);
+
+		// Redirects the final posed points into an external buffer instead of the creature's render points
+		void SetRenderPointsSink(const meshPointsSink& sink_in);
+
+		// Posed points go back to the creature's render points
+		void ClearRenderPointsSink();
+
+		// Returns where the final posed points are written to
+		meshPointsSink GetRenderPointsSink() const;
+
+		// Bumped every time Update() writes a full pose into the render points sink
+		int32 GetRenderPointsSerial() const;
+
+		// Bounds of the points written by the last Update(), reduced while posing
+		const meshPointsBounds& GetRenderPointsBounds() const;
+
+		// Uses the bounds of the whole cached clip instead of reducing every posed point.
+		// Only applies to animations with a point cache.
+		void SetUseClipBounds(bool flag_in);
+
+		// Sets the quality used by PoseCreature, does not apply to posing from a point cache
+		void SetLodSettings(const CreatureLodSettings& settings_in);
+
+		const CreatureLodSettings& GetLodSettings() const;
+
+		// Bounds of the current pose from the baked frame bounds of the playing animations, without posing.
+		// Returns false if any of the animations has no baked bounds.
+		bool GetBakedBounds(meshPointsBounds& bounds_out);
+
+		// Sets the layers posed over the base animation, applied in order before the single skinning pass.
+		// Layers only change bones, displacements and uv warps come from the base animation. Layers keep their
+		// playback time when they stay on the same animation. Point caches are not used while any layer has weight.
+		void SetBlendLayers(const TArray<CreatureBlendLayer>& layers_in);
+
+		const TArray<CreatureBlendLayer>& GetBlendLayers() const;
+
+		bool HasActiveBlendLayers() const;
+
+		// Builds a CreatureBlendLayer bone mask from bone weights by name. With include_children bones that are
+		// not listed take the weight of their closest listed parent, otherwise they get 0.
+		void MakeBoneMask(const TMap<FName, float>& bone_weights_in, bool include_children, TArray<float>& mask_out);
+
+		// Poses the creature at the current time, Update() advances the time before doing this
+		void PoseCurrentTime();
+
+		// Adds everything posing at the current time depends on to key_out, with times quantized to time_step frames,
+		// or to a thousandth of a frame if it is 0. Returns false if the pose can not be cached, like while a bones override callback is set.
+		bool GetPoseInputKey(CreaturePoseKey& key_out, float time_step = 0.0f);
+
+		// Writes x and y of points posed by another CreatureManager of the same character into the render points sink,
+		// in place of PoseCurrentTime. Bones and region opacities are left at their last pose.
+		void SetPosedPoints(const glm::float32 * xy_pts_in, const meshPointsBounds& bounds_in);
     protected:
 
 		bool checkAnimationBlendValid() const;
@@ -353,9 +531,50 @@ namespace CreatureModule {
                                        meshBone * bone_in) const;
 
         
+        // Poses the animation into target_sink. Blend layers are only applied on request, so baked
+        // point caches hold just the animation itself.
         void PoseCreature(const FName& animation_name_in,
-                          glm::float32 * target_pts,
-						  float input_run_time);
+                          const meshPointsSink& target_sink,
+						  float input_run_time,
+						  meshPointsBounds * bounds_out=nullptr,
+						  bool with_blend_layers=false);
+
+		void PoseFromCache(CreatureAnimation * animation_in,
+						   float input_run_time,
+						   const meshPointsSink& target_sink,
+						   meshPointsBounds * bounds_out);
+
+		// Blends the bones and displacements of both blend animations, then poses the creature once
+		void PoseCreatureBlended(const meshPointsSink& target_sink,
+								 meshPointsBounds * bounds_out);
+
+		// Poses both blend animations fully and blends the posed points, used when either one poses from a point cache
+		void PoseBlendedPoints(const meshPointsSink& target_sink,
+							   meshPointsBounds * bounds_out);
+
+		// Reads the bones, and the displacements unless the LOD skips them, of the animation into the creature
+		void RetrieveClipValues(const FName& animation_name_in, float input_run_time);
+
+		// Time the bones are sampled at, quantized by the LOD bone sample step
+		float GetBonesRunTime(CreatureAnimation * animation_in, float input_run_time) const;
+
+		// Copies the world start and end points of all bones into pts_out, in the order of the bones map
+		void FlattenBones(TArray<glm::vec4>& pts_out);
+
+		// Poses the blend layers over the bones of the base animation
+		void ApplyBlendLayers();
+
+		// Bones of the first frame of the animation, additive layers add their motion relative to it
+		const TArray<glm::vec4>& GetAdditiveReference(const FName& animation_name_in);
+
+		void increBlendLayerRuntimes(float delta_in);
+
+		// Reads the uv warps, unless the LOD skips them, and the opacities of the animation into the creature
+		void RetrieveClipAttributes(const FName& animation_name_in, float input_run_time);
+
+		// Updates the transforms and poses all regions of the creature from the current bones
+		void PoseRegions(const meshPointsSink& target_sink,
+						 meshPointsBounds * bounds_out);
         
         void ProcessAutoBlending();
 
@@ -367,6 +586,9 @@ namespace CreatureModule {
 
 		void UpdateRegionSwitches(const FName& animation_name_in);
 
+		// Displacements stay on for regions where either animation has them, uv swaps follow the second animation
+		void UpdateBlendRegionSwitches(const FName& name_1, const FName& name_2);
+
 		void JustRunUVWarps(const FName& animation_name_in, float input_run_time);
 
 		void RunUVItemSwap();
@@ -392,6 +614,17 @@ namespace CreatureModule {
         FName auto_blend_names[2];
         float auto_blend_delta;
 		bool do_point_caching;
+		meshPointsSink render_points_sink;
+		int32 render_points_serial;
+		meshPointsBounds render_points_bounds;
+		bool use_clip_bounds;
+		CreatureLodSettings lod_settings;
+		TArray<glm::vec4> blend_bone_pts;
+		TArray<glm::vec2> blend_displacements;
+		TArray<CreatureBlendLayer> blend_layers;
+		int32 blend_layers_serial;
+		TArray<glm::vec4> layer_pose_pts;
+		TMap<FName, TArray<glm::vec4> > additive_reference_pts;
         
         std::function<void (TMap<FName, meshBone *>&) > bones_override_callback;
         
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CreatureCore.h"
+
+// Finished pose of one character at one quantized time, filled by the first instance that poses it
+struct FCreatureSharedPose
+{
+	// Posed x and y of every point, each instance applies its own region depths
+	TArray<glm::float32> posed_pts;
+	meshPointsBounds posed_bounds;
+	TArray<uint8> region_alphas;
+	// World start and end point of every bone, in the order of the CreatureCore bone data
+	TArray<glm::vec4> bone_pts;
+	// Key the pose was added under and the next pose added this frame whose key has the same hash
+	CreatureModule::CreaturePoseKey key;
+	int32 next_same_hash;
+};
+
+typedef TSharedPtr<FCreatureSharedPose, ESPMode::ThreadSafe> FCreatureSharedPosePtr;
+
+/** Poses shared by all CreatureCores that play the same character with the same clips at about the same time.
+ *  Keys come from CreatureCore::MakeSharedPoseKey, which quantizes the playback times to the step of the instance.
+ *  The first instance to pose a key adds its result, every other instance with the same key copies it instead
+ *  of posing. The cache only lives for one frame, so poses never outlive the time they were made for. */
+class CREATUREPLUGIN_API FCreaturePoseCache
+{
+public:
+	// Returns the pose added for the key this frame, null if there is none. Safe to call from any thread.
+	static FCreatureSharedPosePtr Find(const CreatureModule::CreaturePoseKey& key_in);
+
+	// Returns a pose to fill for Add, reused from an earlier frame when possible. Safe to call from any thread.
+	static FCreatureSharedPosePtr Acquire();
+
+	// Adds the pose for the key, the first pose added for a key this frame wins. Safe to call from any thread.
+	static void Add(const CreatureModule::CreaturePoseKey& key_in, const FCreatureSharedPosePtr& pose_in);
+
+protected:
+	// Hands the poses of the last frame that nobody holds anymore back to the pool, called with the cache lock held
+	static void BeginFrame();
+
+	static int32 FindIndex(const CreatureModule::CreaturePoseKey& key_in);
+
+	static FCriticalSection cache_lock;
+	// Poses of this frame, hashed into pose_slots. Lookups compare the full key, so characters whose key
+	// hashes collide never take each other's pose. Both are reset every frame but keep their memory.
+	static TArray<FCreatureSharedPosePtr> cached_poses;
+	static TMap<uint32, int32> pose_slots;
+	// Poses of earlier frames waiting to be filled again, so a steady state frame does not allocate
+	static TArray<FCreatureSharedPosePtr> free_poses;
+	static uint64 cache_frame;
+};
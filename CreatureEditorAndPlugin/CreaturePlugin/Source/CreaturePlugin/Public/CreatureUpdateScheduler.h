@@ -0,0 +1,130 @@
+#pragma once
+
+#include "Engine.h"
+#include "CreatureUpdateScheduler.generated.h"
+
+class UCreatureMeshComponent;
+class FCreatureUpdateScheduler;
+
+/** Tick function of the update scheduler, either starts the queued creature updates or waits for them to finish */
+USTRUCT()
+struct FCreatureSchedulerTickFunction : public FTickFunction
+{
+	GENERATED_USTRUCT_BODY()
+
+	FCreatureUpdateScheduler * Target;
+
+	bool is_fence;
+
+	virtual void ExecuteTick(float DeltaTime, enum ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FCreatureSchedulerTickFunction> : public TStructOpsTypeTraitsBase2<FCreatureSchedulerTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/** Runs the multicore updates of all Creature Mesh Components in a world as one batch of work.
+ *  Components queue their update from their own tick, which runs in TG_DuringPhysics unless moved. In TG_EndPhysics,
+ *  after all of them queued, one task per worker thread is started,
+ *  every task keeps taking the next queued creature until none are left, largest creatures first.
+ *  In TG_PostPhysics the game thread helps out with what is left, waits on all tasks once and hands the
+ *  results back to the components. Posing inside these tasks walks its chunks inline, so there are no nested waits.
+ *  Components that tick after the batch started update on the game thread, see the CreatureScheduler_LateUpdates stat. */
+class CREATUREPLUGIN_API FCreatureUpdateScheduler
+{
+public:
+	// Returns the scheduler of the world, creating it the first time
+	static FCreatureUpdateScheduler * Get(UWorld * world_in);
+
+	// Returns the scheduler of the world if it has one
+	static FCreatureUpdateScheduler * Find(UWorld * world_in);
+
+	// Queues the update of the component for this frame. Updates queued after the batch started run right away.
+	void QueueUpdate(UCreatureMeshComponent * component_in, float delta_time);
+
+	// Returns if the component gets to pose this frame under the creature.UpdateBudgetMs budget, always true without a budget.
+	// Components turned down only advance their clock and rank higher the more frames they have waited.
+	bool RequestFullUpdate(UCreatureMeshComponent * component_in, float significance, int32 max_skip_frames);
+
+	// Returns if creature.UpdateBudgetMs is set
+	static bool IsBudgetEnabled();
+
+	// Records how long a full update of the component took, the next frames are planned with it
+	void RecordUpdateCost(UCreatureMeshComponent * component_in, float cost_ms);
+
+	// Drops the component from the batch and the budget. If the batch is already running, waits for it first.
+	void RemoveComponent(UCreatureMeshComponent * component_in);
+
+	~FCreatureUpdateScheduler();
+
+protected:
+	FCreatureUpdateScheduler(UWorld * world_in);
+
+	friend struct FCreatureSchedulerTickFunction;
+
+	struct FQueuedUpdate
+	{
+		UCreatureMeshComponent * component;
+		float delta_time;
+		int32 cost;
+		float update_ms;
+		bool result;
+	};
+
+	struct FBudgetEntry
+	{
+		float significance;
+		float cost_ms;
+		int32 frames_skipped;
+		int32 max_skip_frames;
+		uint64 last_request_frame;
+		bool granted;
+	};
+
+	enum class EBatchState : uint8
+	{
+		Queueing,
+		Running,
+		Done
+	};
+
+	// Resets the batch on the first call of a new frame
+	void BeginFrame();
+
+	// Ranks the components that asked for an update last frame and grants updates until the frame budget is used up
+	void PlanBudget();
+
+	void Dispatch();
+
+	// Takes queued updates off the batch until there are none left, runs on the workers and on the game thread
+	void RunQueuedUpdates();
+
+	// Waits for the workers to finish the batch, the game thread helps with what is left
+	void WaitForUpdates();
+
+	void WaitAndProcessResults();
+
+	static void OnWorldCleanup(UWorld * world_in, bool session_ended, bool cleanup_resources);
+
+	UWorld * world;
+	TArray<FQueuedUpdate> queued_updates;
+	volatile int32 next_update_idx;
+	FGraphEventArray update_events;
+	EBatchState batch_state;
+	uint64 batch_frame;
+	FCreatureSchedulerTickFunction dispatch_tick, fence_tick;
+
+	// frame budget state
+	TMap<TWeakObjectPtr<UCreatureMeshComponent>, FBudgetEntry> budget_entries;
+	// Ranking scratch of PlanBudget, kept so planning a frame does not allocate
+	TArray<FBudgetEntry *> ranked_entries;
+	float budget_available_ms, budget_spent_ms, budget_unplanned_ms;
+
+	static TMap<UWorld *, FCreatureUpdateScheduler *> world_schedulers;
+};
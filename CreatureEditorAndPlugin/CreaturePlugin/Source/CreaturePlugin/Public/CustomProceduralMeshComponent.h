@@ -10,6 +10,75 @@
 class UCustomProceduralMeshComponent;
 class FProceduralMeshRenderPacket;
 
+/** Hands complete copies of render data from the game side over to the render thread without locking.
+ *  The game side fills GetWriteBuffer() and calls Publish(), the render thread calls AcquireLatest() and reads GetReadBuffer().
+ *  The buffers are only ever swapped through one atomic index, so neither side touches the buffer the other one is using. */
+template<typename DataType>
+class TCreatureRenderTripleBuffer
+{
+public:
+	TCreatureRenderTripleBuffer()
+		: WriteIdx(0), ReadIdx(1), PublishedIdx(2), ReadyState(2)
+	{
+	}
+
+	/** Sets every buffer, only safe before the render thread starts reading */
+	void Init(const DataType& value_in)
+	{
+		for (int32 i = 0; i < 3; i++)
+		{
+			Buffers[i] = value_in;
+		}
+	}
+
+	DataType& GetWriteBuffer()
+	{
+		return Buffers[WriteIdx];
+	}
+
+	/** The most recently published buffer, for reading on the game side */
+	const DataType& GetLastPublished() const
+	{
+		return Buffers[PublishedIdx];
+	}
+
+	void Publish()
+	{
+		PublishedIdx = WriteIdx;
+		int32 prev_state = FPlatformAtomics::InterlockedExchange(&ReadyState, WriteIdx | DirtyFlag);
+		WriteIdx = prev_state & IndexMask;
+	}
+
+	/** Swaps in the latest published buffer, returns false if nothing was published since the last call */
+	bool AcquireLatest()
+	{
+		if ((ReadyState & DirtyFlag) == 0)
+		{
+			return false;
+		}
+
+		int32 prev_state = FPlatformAtomics::InterlockedExchange(&ReadyState, ReadIdx);
+		ReadIdx = prev_state & IndexMask;
+		return true;
+	}
+
+	const DataType& GetReadBuffer() const
+	{
+		return Buffers[ReadIdx];
+	}
+
+private:
+	enum { IndexMask = 3, DirtyFlag = 4 };
+
+	DataType Buffers[3];
+	int32 WriteIdx, ReadIdx, PublishedIdx;
+	volatile int32 ReadyState;
+};
+
+/** Staging points shared by a CreatureCore and the render packets made from it. Every new render data gets
+ *  its own buffers, so a packet that is still being drawn never sees them reallocated under it. */
+typedef TSharedPtr<TCreatureRenderTripleBuffer<TArray<FVector>>, ESPMode::ThreadSafe> FCreatureStagingPointsPtr;
+
 class FProceduralMeshTriData
 {
 public:
@@ -24,7 +93,8 @@ public:
 		int32 point_num_in,
 		int32 indices_num_in,
 		TArray<uint8> * region_alphas_in,
-		TSharedPtr<FCriticalSection, ESPMode::ThreadSafe> update_lock_in)
+		TSharedPtr<FCriticalSection, ESPMode::ThreadSafe> update_lock_in,
+		FCreatureStagingPointsPtr staging_points_in = nullptr)
 	{
 		indices = indices_in;
 		points = points_in;
@@ -33,6 +103,7 @@ public:
 		indices_num = indices_num_in;
 		region_alphas = region_alphas_in;
 		update_lock = update_lock_in;
+		staging_points = staging_points_in;
 	}
 
 	glm::uint32 * indices;
@@ -41,6 +112,8 @@ public:
 	int32 point_num, indices_num;
 	TArray<uint8> * region_alphas;
 	TSharedPtr<FCriticalSection, ESPMode::ThreadSafe> update_lock;
+	// Optional final vertex positions written directly by posing, used instead of swizzling points
+	FCreatureStagingPointsPtr staging_points;
 };
 
 /** Scene proxy */
@@ -61,13 +134,16 @@ public:
 	
 	void SetActiveRenderPacketIdx(int idxIn);
 
-	void UpdateDynamicComponentData();
+	void UpdateDynamicComponentData(bool update_attributes = false);
 
 	void SetNeedsMaterialUpdate(bool flag_in);
 
 	void SetNeedsIndexUpdate(bool flag_in, int32 index_new_num=-1);
 
 	void UpdateMaterial();
+
+	// Tangents are computed per frame for packets made in Lit mode whose material is lit
+	bool ShouldComputeVertexTangents(const FProceduralMeshRenderPacket& packet_in) const;
 	
 	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views,
 		const FSceneViewFamily& ViewFamily,
@@ -97,7 +173,9 @@ private:
 	FMaterialRelevance MaterialRelevance;
 	bool needs_index_updating;
 	int32 needs_index_update_num;
+	bool needs_attribute_refill;
 	bool needs_material_updating;
+	bool material_needs_tangents;
 
 	mutable FCriticalSection renderPacketsCS;
 };
@@ -135,6 +213,16 @@ struct FProceduralMeshTriangle
 	FProceduralMeshVertex Vertex2;
 };
 
+/** How the tangent basis of the mesh vertices is generated */
+UENUM(BlueprintType)
+enum class ECreatureMeshTangentMode : uint8
+{
+	/** A constant tangent frame is baked once from the rest pose. Cheapest, works for flat unlit or simply lit meshes. */
+	Static,
+	/** Per-vertex tangents are recomputed every update, but only if the material is not unlit */
+	Lit
+};
+
 /** Component that allows you to specify custom triangle mesh geometry */
 UCLASS(editinlinenew, meta = (BlueprintSpawnableComponent), ClassGroup=Rendering)
 class CREATUREPLUGIN_API UCustomProceduralMeshComponent : public UMeshComponent //, public IInterface_CollisionDataProvider
@@ -145,6 +233,13 @@ public:
 
 	void ForceAnUpdate(int render_packet_idx=-1, bool markDirty = true);
 
+	/** Flags the UV and colour stream to be re-uploaded on the next update */
+	void MarkAttributesDirty();
+
+	/** How vertex tangents are generated. Changes take effect when the render proxy is recreated. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature")
+	ECreatureMeshTangentMode tangent_mode;
+
 	/** Description of collision */
 	UPROPERTY(BlueprintReadOnly, Category="Collision")
 	class UBodySetup* ModelBodySetup;
@@ -177,6 +272,9 @@ public:
 
 	void SetBoundsOffset(const FVector& offset_in);
 
+	/** Local space bounds of the points posed for the next update, skips the scan over all vertices in ProcessCalcBounds */
+	void SetPoseBounds(const FBox& bounds_in);
+
 	void SetTagString(FString tag_in);
 
 	void RecreateRenderProxy(bool flag_in);
@@ -204,6 +302,7 @@ protected:
 	FVector bounds_offset;
 	mutable FSphere debugSphere;
 	FVector calc_local_vec_min, calc_local_vec_max;
+	FBox pose_bounds;
 	FCProceduralMeshSceneProxy * GetLocalRenderProxy()
 	{
 		return (FCProceduralMeshSceneProxy*)SceneProxy;
@@ -211,4 +310,5 @@ protected:
 	bool render_proxy_ready;
 	FCriticalSection local_lock;
 	bool recreate_render_proxy;
+	bool attributes_dirty;
 };
@@ -196,6 +196,122 @@ protected:
 	meshBone * parent;
 };
 
+// Destination that posed points are written into. The default layout is packed x,y,z floats.
+// A custom stride and axis order lets posing write straight into render staging memory,
+// with an optional per point z table supplying the region depth in the same pass.
+class meshPointsSink {
+public:
+    meshPointsSink(glm::float32 * pts_in = nullptr,
+                   int32 stride_in = 3,
+                   int32 x_id_in = 0,
+                   int32 y_id_in = 1,
+                   int32 z_id_in = 2,
+                   const glm::float32 * z_values_in = nullptr)
+    : pts(pts_in), z_values(z_values_in), stride(stride_in),
+      x_id(x_id_in), y_id(y_id_in), z_id(z_id_in)
+    {
+    }
+    
+    // Returns a sink that starts at point index_in
+    meshPointsSink offset(int32 index_in) const
+    {
+        return meshPointsSink(pts + (index_in * stride),
+                              stride, x_id, y_id, z_id,
+                              z_values ? (z_values + index_in) : nullptr);
+    }
+    
+    glm::float32 * getPt(int32 index_in) const
+    {
+        return pts + (index_in * stride);
+    }
+    
+    void setPt(int32 index_in, glm::float32 x_in, glm::float32 y_in) const
+    {
+        glm::float32 * write_pt = getPt(index_in);
+        write_pt[x_id] = x_in;
+        write_pt[y_id] = y_in;
+        write_pt[z_id] = z_values ? z_values[index_in] : 0;
+    }
+    
+    void setZ(int32 index_in, glm::float32 z_in) const
+    {
+        getPt(index_in)[z_id] = z_in;
+    }
+    
+    bool isValid() const
+    {
+        return pts != nullptr;
+    }
+    
+    glm::float32 * pts;
+    const glm::float32 * z_values;
+    int32 stride, x_id, y_id, z_id;
+};
+
+// 2D min/max of posed points, produced as a by-product of posing
+class meshPointsBounds {
+public:
+    meshPointsBounds()
+    {
+        reset();
+    }
+    
+    void reset()
+    {
+        min_pt = glm::vec2(FLT_MAX, FLT_MAX);
+        max_pt = glm::vec2(-FLT_MAX, -FLT_MAX);
+    }
+    
+    bool isValid() const
+    {
+        return (min_pt.x <= max_pt.x) && (min_pt.y <= max_pt.y);
+    }
+    
+    void add(glm::float32 x_in, glm::float32 y_in)
+    {
+        min_pt.x = FMath::Min(min_pt.x, x_in);
+        min_pt.y = FMath::Min(min_pt.y, y_in);
+        max_pt.x = FMath::Max(max_pt.x, x_in);
+        max_pt.y = FMath::Max(max_pt.y, y_in);
+    }
+    
+    void add(const meshPointsBounds& other_in)
+    {
+        if (other_in.isValid())
+        {
+            add(other_in.min_pt.x, other_in.min_pt.y);
+            add(other_in.max_pt.x, other_in.max_pt.y);
+        }
+    }
+    
+    // Bounds of the points mirrored along the Y-Axis
+    void mirrorX()
+    {
+        if (isValid())
+        {
+            glm::float32 old_min_x = min_pt.x;
+            min_pt.x = -max_pt.x;
+            max_pt.x = -old_min_x;
+        }
+    }
+    
+    glm::vec2 min_pt, max_pt;
+};
+
+// Points posed per worker chunk, so bounds are reduced once per chunk instead of per point
+#define MESH_POSE_CHUNK_SIZE 256
+
+// Scheduler workers that ran out of queued creature updates this frame
+extern volatile int32 mesh_pose_idle_workers;
+
+// Posing that already runs on a worker thread, like a scheduled creature update, walks its
+// chunks inline instead of fanning out more tasks and waiting on them. Once workers run out of
+// creatures, the ones still posing split their chunks into tasks for the idle workers.
+inline bool meshPoseSingleThreaded()
+{
+    return !IsInGameThread() && (mesh_pose_idle_workers == 0);
+}
+
 class meshRenderRegion {
 public:
     meshRenderRegion(glm::uint32 * indices_in,
@@ -234,10 +350,11 @@ public:
     void poseFinalPts(glm::float32 * output_pts,
                       TMap<FName, meshBone *>& bones_map);
     
-    void poseFastFinalPts(glm::float32 * output_pts,
+    void poseFastFinalPts(const meshPointsSink& output_sink,
 						  bool try_local_displacements=true,
 						  bool try_post_displacements=true,
-						  bool try_uv_swap=true);
+						  bool try_uv_swap=true,
+						  meshPointsBounds * bounds_out=nullptr);
     
     void setMainBoneKey(const FName& key_in);
 
@@ -298,6 +415,11 @@ public:
     void setTagId(int32 value_in);
     
     void initFastNormalWeightMap(const TMap<FName, meshBone *>& bones_map);
+    
+    // Limits skinning to the strongest bones of each point, 0 uses every bone above the weight cutoff
+    void setMaxBoneInfluences(int32 value_in);
+    
+    int32 getMaxBoneInfluences() const;
 
 	void setUVLevel(int32 value_in);
 
@@ -330,8 +452,11 @@ protected:
     TArray<TArray<float> > fast_normal_weight_map;
     TArray<TArray<float> > reverse_fast_normal_weight_map;
     TArray<meshBone *> fast_bones_map;
+    // Sorted from the strongest to the weakest bone
     TArray<TArray<int32> > relevant_bones_indices;
+    int32 max_bone_influences;
     TArray<dualQuat> fill_dq_array;
+    TArray<meshPointsBounds> chunk_bounds;
     FName main_bone_key;
     meshBone * main_bone;
     bool use_dq;
@@ -1,5 +1,6 @@
 #include "CreaturePackAnimationAssetFactory.h"
 #include "CreaturePackAnimationAsset.h"
+#include "CreaturePackQuantizer.hpp"
 #include "Developer/DesktopPlatform/Public/IDesktopPlatform.h"
 #include "Developer/DesktopPlatform/Public/DesktopPlatformModule.h"
 #include <string>
@@ -54,6 +55,20 @@ bool UCreaturePackAnimationAssetFactory::ImportSourceFile(UCreaturePackAnimation
 		return false;
 	}
 
+	if (forAsset->quantize_on_import)
+	{
+		std::vector<uint8_t> srcBytes(readBytes.GetData(), readBytes.GetData() + readBytes.Num());
+		CreaturePackQuantizer quantizer(forAsset->keyframe_error_tolerance);
+		std::vector<uint8_t> dstBytes = quantizer.convert(srcBytes);
+		if (quantizer.verify(srcBytes, dstBytes))
+		{
+			readBytes = TArray<uint8>(dstBytes.data(), (int32)dstBytes.size());
+		}
+		else {
+			UE_LOG(LogTemp, Warning, TEXT("UCreaturePackAnimationAssetFactory::ImportSourceFile() - Quantized pack of %s does not match the source, importing it unquantized"), *creatureFilename);
+		}
+	}
+
 	forAsset->CreatureZipBinary.Reset();
 	FArchiveSaveCompressedProxy Compressor =
 		FArchiveSaveCompressedProxy(forAsset->CreatureZipBinary, ECompressionFlags::COMPRESS_ZLIB);
@@ -37,6 +37,7 @@
 
 static TMap<FString, CreaturePackLoader *> globalCreaturePackLoaders;
 static std::mutex loadLock;
+static CreaturePackFrameCache globalCreaturePackFrameCache;
 
 // UCreaturePackMeshComponent
 UCreaturePackMeshComponent::UCreaturePackMeshComponent(const FObjectInitializer& ObjectInitializer)
@@ -51,6 +52,8 @@ UCreaturePackMeshComponent::UCreaturePackMeshComponent(const FObjectInitializer&
 	creature_debug_draw = false;
 	attach_vertex_id = -1;
 	region_offset_z = 0.01f;
+	use_shared_frame_cache = false;
+	shared_frame_cache_time_step = 0.5f;
 }
 
 void UCreaturePackMeshComponent::SetActiveAnimation(FString name_in)
@@ -161,6 +164,11 @@ UCreaturePackMeshComponent::loadPackData(const FString& filenameIn,
 		raw_data[i] = fileData[i];
 	}
 
+	if (globalCreaturePackLoaders.Contains(filenameIn))
+	{
+		globalCreaturePackFrameCache.clear();
+	}
+
 	globalCreaturePackLoaders.Add(filenameIn, new CreaturePackLoader(raw_data));
 
 	return true;
@@ -263,10 +271,16 @@ UCreaturePackMeshComponent::runTick(float deltaTime)
 		return;
 	}
 
+	playerObj->setFrameCache(use_shared_frame_cache ? &globalCreaturePackFrameCache : nullptr, shared_frame_cache_time_step);
 	playerObj->stepTime(deltaTime * animation_speed);
 	playerObj->syncRenderData();
 	runRegionOffsetZs();
 
+	if (playerObj->uvsChanged)
+	{
+		MarkAttributesDirty();
+	}
+
 	animation_frame = playerObj->getRunTime();
 
 	doCreatureMeshUpdate();
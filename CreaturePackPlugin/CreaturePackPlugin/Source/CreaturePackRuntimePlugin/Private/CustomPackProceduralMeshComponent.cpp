@@ -6,29 +6,62 @@
 #include "DynamicMeshBuilder.h"
 #include "Runtime/Launch/Resources/Version.h"
 
+/** Tangent basis, baked once from the rest pose since the pack mesh stays planar */
+struct FPackMeshTangentVertex
+{
+	FPackedNormal TangentX;
+	FPackedNormal TangentZ;
+
+	void SetTangents(const FVector& InTangentX, const FVector& InTangentY, const FVector& InTangentZ)
+	{
+		TangentX = InTangentX;
+		TangentZ = InTangentZ;
+		// store determinant of basis in w component of normal vector
+		TangentZ.Vector.W = GetBasisDeterminantSign(InTangentX, InTangentY, InTangentZ) < 0.0f ? 0 : 255;
+	}
+};
+
+/** Vertex data that only changes on uv swaps or color changes */
+struct FPackMeshAttributeVertex
+{
+	FVector2D TextureCoordinate;
+	FColor Color;
+};
+
 /** Vertex Buffer */
-class FProceduralMeshVertexBuffer : public FVertexBuffer
+template<typename VertexType>
+class TProceduralMeshVertexBuffer : public FVertexBuffer
 {
 public:
-	TArray<FDynamicMeshVertex> Vertices;
+	TProceduralMeshVertexBuffer(uint32 UsageIn)
+		: Usage(UsageIn)
+	{
+	}
+
+	TArray<VertexType> Vertices;
+	uint32 Usage;
 
 	virtual void InitRHI() override
 	{
 		FRHIResourceCreateInfo CreateInfo;
-		VertexBufferRHI = RHICreateVertexBuffer(Vertices.Num() * sizeof(FDynamicMeshVertex), BUF_Static, CreateInfo);
+		VertexBufferRHI = RHICreateVertexBuffer(Vertices.Num() * sizeof(VertexType), Usage, CreateInfo);
 		UpdateRenderData();
 	}
 
 	void UpdateRenderData() const
 	{
 		// Copy the vertex data into the vertex buffer.
-		void* VertexBufferData = RHILockVertexBuffer(VertexBufferRHI, 0, Vertices.Num() * sizeof(FDynamicMeshVertex), RLM_WriteOnly);
-		FMemory::Memcpy(VertexBufferData, Vertices.GetData(), Vertices.Num() * sizeof(FDynamicMeshVertex));
+		void* VertexBufferData = RHILockVertexBuffer(VertexBufferRHI, 0, Vertices.Num() * sizeof(VertexType), RLM_WriteOnly);
+		FMemory::Memcpy(VertexBufferData, Vertices.GetData(), Vertices.Num() * sizeof(VertexType));
 		RHIUnlockVertexBuffer(VertexBufferRHI);
 	}
 
 };
 
+typedef TProceduralMeshVertexBuffer<FVector> FProceduralMeshPositionVertexBuffer;
+typedef TProceduralMeshVertexBuffer<FPackMeshTangentVertex> FProceduralMeshTangentVertexBuffer;
+typedef TProceduralMeshVertexBuffer<FPackMeshAttributeVertex> FProceduralMeshAttributeVertexBuffer;
+
 /** Index Buffer */
 class FProceduralMeshIndexBuffer : public FIndexBuffer
 {
@@ -60,25 +93,28 @@ public:
 	}
 
 	/** Initialization */
-	void Init(const FProceduralMeshVertexBuffer* VertexBuffer)
+	void Init(const FProceduralMeshPositionVertexBuffer* PositionVertexBuffer, const FProceduralMeshTangentVertexBuffer* TangentVertexBuffer, const FProceduralMeshAttributeVertexBuffer* AttributeVertexBuffer)
 	{
 		// Commented out to enable building light of a level (but no backing is done for the procedural mesh itself)
 		//check(!IsInRenderingThread());
 
-		ENQUEUE_UNIQUE_RENDER_COMMAND_TWOPARAMETER(
+		ENQUEUE_UNIQUE_RENDER_COMMAND_FOURPARAMETER(
 			InitProceduralMeshVertexFactory,
 			FProceduralMeshVertexFactory*, VertexFactory, this,
-			const FProceduralMeshVertexBuffer*, VertexBuffer, VertexBuffer,
+			const FProceduralMeshPositionVertexBuffer*, PositionVertexBuffer, PositionVertexBuffer,
+			const FProceduralMeshTangentVertexBuffer*, TangentVertexBuffer, TangentVertexBuffer,
+			const FProceduralMeshAttributeVertexBuffer*, AttributeVertexBuffer, AttributeVertexBuffer,
 		{
 			// Initialize the vertex factory's stream components.
+			// Positions, Tangents and UVs/Colors live in separate streams so only the positions get uploaded every frame
 			FDataType NewData;
-			NewData.PositionComponent = STRUCTMEMBER_VERTEXSTREAMCOMPONENT(VertexBuffer,FDynamicMeshVertex,Position,VET_Float3);
+			NewData.PositionComponent = FVertexStreamComponent(PositionVertexBuffer,0,sizeof(FVector),VET_Float3);
+			NewData.TangentBasisComponents[0] = STRUCTMEMBER_VERTEXSTREAMCOMPONENT(TangentVertexBuffer,FPackMeshTangentVertex,TangentX,VET_PackedNormal);
+			NewData.TangentBasisComponents[1] = STRUCTMEMBER_VERTEXSTREAMCOMPONENT(TangentVertexBuffer,FPackMeshTangentVertex,TangentZ,VET_PackedNormal);
 			NewData.TextureCoordinates.Add(
-				FVertexStreamComponent(VertexBuffer,STRUCT_OFFSET(FDynamicMeshVertex,TextureCoordinate),sizeof(FDynamicMeshVertex),VET_Float2)
+				FVertexStreamComponent(AttributeVertexBuffer,STRUCT_OFFSET(FPackMeshAttributeVertex,TextureCoordinate),sizeof(FPackMeshAttributeVertex),VET_Float2)
 				);
-			NewData.TangentBasisComponents[0] = STRUCTMEMBER_VERTEXSTREAMCOMPONENT(VertexBuffer,FDynamicMeshVertex,TangentX,VET_PackedNormal);
-			NewData.TangentBasisComponents[1] = STRUCTMEMBER_VERTEXSTREAMCOMPONENT(VertexBuffer,FDynamicMeshVertex,TangentZ,VET_PackedNormal);
-			NewData.ColorComponent = STRUCTMEMBER_VERTEXSTREAMCOMPONENT(VertexBuffer, FDynamicMeshVertex, Color, VET_Color);
+			NewData.ColorComponent = STRUCTMEMBER_VERTEXSTREAMCOMPONENT(AttributeVertexBuffer, FPackMeshAttributeVertex, Color, VET_Color);
 			VertexFactory->SetData(NewData);
 		});
 	}
@@ -89,6 +125,7 @@ class FProceduralPackMeshRenderPacket
 {
 public:
 	FProceduralPackMeshRenderPacket(FProceduralPackMeshTriData * data_in)
+		: VertexBuffer(BUF_Dynamic), TangentVertexBuffer(BUF_Static), AttributeVertexBuffer(BUF_Static)
 	{
 		indices = data_in->indices;
 		points = data_in->points;
@@ -104,6 +141,8 @@ public:
 	{
 		if (should_release) {
 			VertexBuffer.ReleaseResource();
+			TangentVertexBuffer.ReleaseResource();
+			AttributeVertexBuffer.ReleaseResource();
 			IndexBuffer.ReleaseResource();
 			VertexFactory.ReleaseResource();
 		}
@@ -112,6 +151,8 @@ public:
 	void InitForRender()
 	{
 		BeginInitResource(&VertexBuffer);
+		BeginInitResource(&TangentVertexBuffer);
+		BeginInitResource(&AttributeVertexBuffer);
 		BeginInitResource(&IndexBuffer);
 		BeginInitResource(&VertexFactory);
 
@@ -126,44 +167,38 @@ public:
 
 		std::lock_guard<std::mutex> scope_lock(*update_lock);
 
-		FDynamicMeshVertex* VertexBufferData = (FDynamicMeshVertex *)RHILockVertexBuffer(VertexBuffer.VertexBufferRHI, 0, this->point_num * sizeof(FDynamicMeshVertex), RLM_WriteOnly);
+		// Tangents are baked in AddRenderPacket(), only the positions change per frame
+		FVector* VertexBufferData = (FVector *)RHILockVertexBuffer(VertexBuffer.VertexBufferRHI, 0, this->point_num * sizeof(FVector), RLM_WriteOnly);
 
 		for (int32 i = 0; i < this->point_num; i++)
 		{
-			FDynamicMeshVertex* curVert = VertexBufferData + i;
-
 			int pos_idx = i * 3;
-			curVert->Position = FVector(this->points[pos_idx + x_id],
+			VertexBufferData[i] = FVector(this->points[pos_idx + x_id],
 				this->points[pos_idx + y_id],
 				this->points[pos_idx + z_id]);
+		}
 
-			float set_alpha = (*this->region_alphas)[i];
-			curVert->Color = FColor(set_alpha, set_alpha, set_alpha, set_alpha);
+		RHIUnlockVertexBuffer(VertexBuffer.VertexBufferRHI);
+	}
 
-			int uv_idx = i * 2;
-			curVert->TextureCoordinate.Set(this->uvs[uv_idx], this->uvs[uv_idx + 1]);
-		}
+	void UpdateDirectAttributeData() const
+	{
+		std::lock_guard<std::mutex> scope_lock(*update_lock);
 
-		// Set Tangents
-		for (int cur_indice = 0; cur_indice < indices_num; cur_indice += 3)
-		{
-			FDynamicMeshVertex * vert0 = VertexBufferData + (indices[cur_indice]);
-			FDynamicMeshVertex * vert1 = VertexBufferData + (indices[cur_indice + 1]);
-			FDynamicMeshVertex * vert2 = VertexBufferData + (indices[cur_indice + 2]);
+		FPackMeshAttributeVertex* VertexBufferData = (FPackMeshAttributeVertex *)RHILockVertexBuffer(AttributeVertexBuffer.VertexBufferRHI, 0, this->point_num * sizeof(FPackMeshAttributeVertex), RLM_WriteOnly);
 
-			const FVector Edge01 = (vert1->Position - vert0->Position);
-			const FVector Edge02 = (vert2->Position - vert0->Position);
+		for (int32 i = 0; i < this->point_num; i++)
+		{
+			FPackMeshAttributeVertex* curVert = VertexBufferData + i;
 
-			const FVector TangentX = Edge01.GetSafeNormal();
-			const FVector TangentZ = (Edge02 ^ Edge01).GetSafeNormal();
-			const FVector TangentY = (TangentX ^ TangentZ).GetSafeNormal();
+			float set_alpha = (*this->region_alphas)[i];
+			curVert->Color = FColor(set_alpha, set_alpha, set_alpha, set_alpha);
 
-			vert0->SetTangents(TangentX, TangentY, TangentZ);
-			vert1->SetTangents(TangentX, TangentY, TangentZ);
-			vert2->SetTangents(TangentX, TangentY, TangentZ);
+			int uv_idx = i * 2;
+			curVert->TextureCoordinate.Set(this->uvs[uv_idx], this->uvs[uv_idx + 1]);
 		}
 
-		RHIUnlockVertexBuffer(VertexBuffer.VertexBufferRHI);
+		RHIUnlockVertexBuffer(AttributeVertexBuffer.VertexBufferRHI);
 	}
 
 	void UpdateDirectIndexData() const
@@ -176,7 +211,9 @@ public:
 		RHIUnlockIndexBuffer(IndexBuffer.IndexBufferRHI);
 	}
 
-	FProceduralMeshVertexBuffer VertexBuffer;
+	FProceduralMeshPositionVertexBuffer VertexBuffer;
+	FProceduralMeshTangentVertexBuffer TangentVertexBuffer;
+	FProceduralMeshAttributeVertexBuffer AttributeVertexBuffer;
 	FProceduralMeshIndexBuffer IndexBuffer;
 	FProceduralMeshVertexFactory VertexFactory;
 	uint32 * indices;
@@ -198,6 +235,8 @@ FCProceduralPackMeshSceneProxy::FCProceduralPackMeshSceneProxy(UCustomPackProced
 	parentComponent = Component;
 	needs_updating = false;
 	needs_index_updating = false;
+	needs_attribute_updating = false;
+	needs_material_updating = false;
 	active_render_packet_idx = INDEX_NONE;
 
 	UpdateMaterial();
@@ -243,10 +282,14 @@ void FCProceduralPackMeshSceneProxy::AddRenderPacket(FProceduralPackMeshTriData
 
 	auto& IndexBuffer = cur_packet.IndexBuffer;
 	auto& VertexBuffer = cur_packet.VertexBuffer;
+	auto& TangentVertexBuffer = cur_packet.TangentVertexBuffer;
+	auto& AttributeVertexBuffer = cur_packet.AttributeVertexBuffer;
 	auto& VertexFactory = cur_packet.VertexFactory;
 
 	IndexBuffer.Indices.SetNum(cur_packet.indices_num);
 	VertexBuffer.Vertices.SetNum(cur_packet.point_num);
+	TangentVertexBuffer.Vertices.SetNum(cur_packet.point_num);
+	AttributeVertexBuffer.Vertices.SetNum(cur_packet.point_num);
 
 	// Set topology/indices
 	for (int32 i = 0; i < cur_packet.indices_num; i++)
@@ -261,39 +304,38 @@ void FCProceduralPackMeshSceneProxy::AddRenderPacket(FProceduralPackMeshTriData
 	// Fill initial points
 	for (int32 i = 0; i < cur_packet.point_num; i++)
 	{
-		FDynamicMeshVertex Vert0;
 		int pos_idx = i * 3;
-		Vert0.Position = FVector(cur_packet.points[pos_idx + x_id], cur_packet.points[pos_idx + y_id], cur_packet.points[pos_idx + z_id]);
-
-		Vert0.Color = FColor::White;
-		Vert0.SetTangents(FVector(1, 0, 0), FVector(0, 1, 0), FVector(0, 0, 1));
+		VertexBuffer.Vertices[i] = FVector(cur_packet.points[pos_idx + x_id], cur_packet.points[pos_idx + y_id], cur_packet.points[pos_idx + z_id]);
+		TangentVertexBuffer.Vertices[i].SetTangents(FVector(1, 0, 0), FVector(0, 1, 0), FVector(0, 0, 1));
 
+		FPackMeshAttributeVertex AttributeVert0;
+		AttributeVert0.Color = FColor::White;
 		int uv_idx = i * 2;
-		Vert0.TextureCoordinate.Set(cur_packet.uvs[uv_idx], cur_packet.uvs[uv_idx + 1]);
-		VertexBuffer.Vertices[i] = Vert0;
+		AttributeVert0.TextureCoordinate.Set(cur_packet.uvs[uv_idx], cur_packet.uvs[uv_idx + 1]);
+		AttributeVertexBuffer.Vertices[i] = AttributeVert0;
 	}
 
-	// Set Initial Rest Tangents
+	// Set Rest Tangents, these are not recomputed per frame
 	for (int cur_indice = 0; cur_indice < cur_packet.indices_num; cur_indice += 3)
 	{
-		FDynamicMeshVertex& vert0 = VertexBuffer.Vertices[cur_packet.indices[cur_indice]];
-		FDynamicMeshVertex& vert1 = VertexBuffer.Vertices[cur_packet.indices[cur_indice + 1]];
-		FDynamicMeshVertex& vert2 = VertexBuffer.Vertices[cur_packet.indices[cur_indice + 2]];
+		const uint32 idx0 = cur_packet.indices[cur_indice];
+		const uint32 idx1 = cur_packet.indices[cur_indice + 1];
+		const uint32 idx2 = cur_packet.indices[cur_indice + 2];
 
-		const FVector Edge01 = (vert1.Position - vert0.Position);
-		const FVector Edge02 = (vert2.Position - vert0.Position);
+		const FVector Edge01 = (VertexBuffer.Vertices[idx1] - VertexBuffer.Vertices[idx0]);
+		const FVector Edge02 = (VertexBuffer.Vertices[idx2] - VertexBuffer.Vertices[idx0]);
 
 		const FVector TangentX = Edge01.GetSafeNormal();
 		const FVector TangentZ = (Edge02 ^ Edge01).GetSafeNormal();
 		const FVector TangentY = (TangentX ^ TangentZ).GetSafeNormal();
 
-		vert0.SetTangents(TangentX, TangentY, TangentZ);
-		vert1.SetTangents(TangentX, TangentY, TangentZ);
-		vert2.SetTangents(TangentX, TangentY, TangentZ);
+		TangentVertexBuffer.Vertices[idx0].SetTangents(TangentX, TangentY, TangentZ);
+		TangentVertexBuffer.Vertices[idx1].SetTangents(TangentX, TangentY, TangentZ);
+		TangentVertexBuffer.Vertices[idx2].SetTangents(TangentX, TangentY, TangentZ);
 	}
 
 	// Init vertex factory
-	VertexFactory.Init(&VertexBuffer);
+	VertexFactory.Init(&VertexBuffer, &TangentVertexBuffer, &AttributeVertexBuffer);
 
 	// Enqueue initialization of render resource
 	cur_packet.InitForRender();
@@ -382,6 +424,7 @@ void FCProceduralPackMeshSceneProxy::DoneUpdating()
 {
 	needs_updating = false;
 	needs_index_updating = false;
+	needs_attribute_updating = false;
 	needs_material_updating = false;
 }
 
@@ -395,6 +438,11 @@ void FCProceduralPackMeshSceneProxy::SetNeedsIndexUpdate(bool flag_in)
 	needs_index_updating = flag_in;
 }
 
+void FCProceduralPackMeshSceneProxy::SetNeedsAttributeUpdate(bool flag_in)
+{
+	needs_attribute_updating = flag_in;
+}
+
 void FCProceduralPackMeshSceneProxy::GetDynamicMeshElements(const TArray<const FSceneView*>& Views,
 	const FSceneViewFamily& ViewFamily,
 	uint32 VisibilityMap,
@@ -417,6 +465,9 @@ void FCProceduralPackMeshSceneProxy::GetDynamicMeshElements(const TArray<const F
 
 	if (needs_updating) {
 		cur_packet.UpdateDirectVertexData();
+		if (needs_attribute_updating) {
+			cur_packet.UpdateDirectAttributeData();
+		}
 		if (needs_index_updating) {
 			cur_packet.UpdateDirectIndexData();
 		}
@@ -513,6 +564,7 @@ UCustomPackProceduralMeshComponent::UCustomPackProceduralMeshComponent(const FOb
 	calc_local_vec_max = FVector(FLT_MAX, FLT_MAX, FLT_MAX);
 	bWantsInitializeComponent = true;
 	recreate_render_proxy = false;
+	attributes_dirty = false;
 
 //	SetCollisionProfileName(UCollisionProfile::BlockAllDynamic_ProfileName);
 	SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
@@ -535,6 +587,12 @@ void UCustomPackProceduralMeshComponent::RecreateRenderProxy(bool flag_in)
 	recreate_render_proxy = flag_in;
 }
 
+void UCustomPackProceduralMeshComponent::MarkAttributesDirty()
+{
+	std::lock_guard<std::mutex> cur_lock(local_lock);
+	attributes_dirty = true;
+}
+
 void UCustomPackProceduralMeshComponent::ForceAnUpdate(int render_packet_idx)
 {
 	// Need to recreate scene proxy to send it over
@@ -553,6 +611,12 @@ void UCustomPackProceduralMeshComponent::ForceAnUpdate(int render_packet_idx)
 			localRenderProxy->SetActiveRenderPacketIdx(render_packet_idx);
 		}
 
+		if (attributes_dirty)
+		{
+			localRenderProxy->SetNeedsAttributeUpdate(true);
+			attributes_dirty = false;
+		}
+
 		localRenderProxy->UpdateDynamicComponentData();
 		ProcessCalcBounds(localRenderProxy);
 		MarkRenderTransformDirty();
@@ -3,6 +3,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <cassert>
 
 
 namespace mpMini {
@@ -285,12 +286,19 @@ namespace mpMini {
 				uint32_t array_size;
 				msg_mini_read_array(&array_size);
 
+				// empty arrays have no element to tell their type, they are written back as empty arrays
+				if (array_size == 0)
+				{
+					generic_data.push_back(msg_mini_generic_data(MSG_MINI_GENERIC_ARRAY_EMPTY_TYPE));
+					continue;
+				}
+
 				// determine array type
 				store_read_pos();
 				msg_mini_read_object(&test_msg_obj);
 				restore_read_pos();
 
-				msg_mini_generic_data new_generic_data(0);
+				msg_mini_generic_data new_generic_data(MSG_MINI_GENERIC_ARRAY_EMPTY_TYPE);
 
 				if (msg_mini_object_is_uint(&test_msg_obj))
 				{
@@ -322,6 +330,11 @@ namespace mpMini {
 						msg_mini_read_str(new_generic_data.str_array_val[j]);
 					}
 				}
+				else {
+					// not supported array element type so just stop
+					error = INVALID_TYPE_ERROR;
+					return false;
+				}
 
 				generic_data.push_back(new_generic_data);
 			}
@@ -343,6 +356,13 @@ namespace mpMini {
 				msg_mini_read_str(new_generic_data.string_val);
 				generic_data.push_back(new_generic_data);
 			}
+			else if (msg_mini_object_is_bin(&read_msg_obj))
+			{
+				// bin blobs are always packed int16 arrays
+				msg_mini_generic_data new_generic_data(MSG_MINI_GENERIC_ARRAY_SHORT_TYPE);
+				msg_mini_read_short_bin(new_generic_data.short_array_val);
+				generic_data.push_back(new_generic_data);
+			}
 			else {
 				// not supported type so just stop
 				error = INVALID_TYPE_ERROR;
@@ -745,6 +765,56 @@ namespace mpMini {
 		}
 	}
 
+	bool 
+	msg_mini::msg_mini_read_bin_size(uint32_t *size) 
+	{
+		msg_mini_object obj;
+
+		if (!msg_mini_read_object(&obj))
+			return false;
+
+		switch (obj.type) {
+		case MSG_MINI_TYPE_BIN8:
+		case MSG_MINI_TYPE_BIN16:
+		case MSG_MINI_TYPE_BIN32:
+			*size = obj.as.bin_size;
+			return true;
+		default:
+			error = INVALID_TYPE_ERROR;
+			return false;
+		}
+	}
+
+	bool 
+	msg_mini::msg_mini_read_short_bin(std::vector<int16_t>& data)
+	{
+		uint32_t bin_size = 0;
+
+		if (!msg_mini_read_bin_size(&bin_size))
+			return false;
+
+		if ((bin_size % 2) != 0) {
+			error = INVALID_TYPE_ERROR;
+			return false;
+		}
+
+		if ((size_t)read_idx + bin_size > buf.size()) {
+			error = DATA_READING_ERROR;
+			return false;
+		}
+
+		data.resize(bin_size / 2);
+		const uint8_t * base_ptr = buf.data() + read_idx;
+		for (size_t i = 0; i < data.size(); i++)
+		{
+			data[i] = (int16_t)((uint16_t)base_ptr[i * 2] | ((uint16_t)base_ptr[i * 2 + 1] << 8));
+		}
+
+		read_idx += bin_size;
+
+		return true;
+	}
+
 	bool 
 	msg_mini::msg_mini_read_object(msg_mini_object *obj)
 	{
@@ -781,6 +851,30 @@ namespace mpMini {
 			obj->type = MSG_MINI_TYPE_BOOLEAN;
 			obj->as.boolean = true;
 		}
+		else if (type_marker == BIN8_MARKER) {
+			obj->type = MSG_MINI_TYPE_BIN8;
+			if (!read(&obj->as.u8, sizeof(uint8_t))) {
+				error = LENGTH_READING_ERROR;
+				return false;
+			}
+			obj->as.bin_size = obj->as.u8;
+		}
+		else if (type_marker == BIN16_MARKER) {
+			obj->type = MSG_MINI_TYPE_BIN16;
+			if (!read(&obj->as.u16, sizeof(uint16_t))) {
+				error = LENGTH_READING_ERROR;
+				return false;
+			}
+			obj->as.bin_size = be16(obj->as.u16);
+		}
+		else if (type_marker == BIN32_MARKER) {
+			obj->type = MSG_MINI_TYPE_BIN32;
+			if (!read(&obj->as.u32, sizeof(uint32_t))) {
+				error = LENGTH_READING_ERROR;
+				return false;
+			}
+			obj->as.bin_size = be32(obj->as.u32);
+		}
 		else if (type_marker == FLOAT_MARKER) {
 			obj->type = MSG_MINI_TYPE_FLOAT;
 			if (!read(&obj->as.flt, sizeof(float))) {
@@ -1124,6 +1218,19 @@ namespace mpMini {
 		}
 	}
 
+	bool 
+	msg_mini::msg_mini_object_is_bin(msg_mini_object *obj) 
+	{
+		switch (obj->type) {
+		case MSG_MINI_TYPE_BIN8:
+		case MSG_MINI_TYPE_BIN16:
+		case MSG_MINI_TYPE_BIN32:
+			return true;
+		default:
+			return false;
+		}
+	}
+
 	bool 
 	msg_mini::msg_mini_object_as_char(msg_mini_object *obj, int8_t *c) 
 	{
@@ -1348,4 +1455,220 @@ namespace mpMini {
 			return false;
 		}
 	}
+
+	/*
+	* Writer
+	*/
+
+	void 
+	msg_mini_writer::write_array_size(uint32_t size)
+	{
+		uint8_t marker = 0;
+		if (size <= FIXARRAY_SIZE) {
+			marker = (uint8_t)(FIXARRAY_MARKER | size);
+			write_bytes(&marker, sizeof(uint8_t));
+		}
+		else if (size <= 0xFFFF) {
+			marker = ARRAY16_MARKER;
+			uint16_t be_size = be16((uint16_t)size);
+			write_bytes(&marker, sizeof(uint8_t));
+			write_bytes(&be_size, sizeof(uint16_t));
+		}
+		else {
+			marker = ARRAY32_MARKER;
+			uint32_t be_size = be32(size);
+			write_bytes(&marker, sizeof(uint8_t));
+			write_bytes(&be_size, sizeof(uint32_t));
+		}
+	}
+
+	void 
+	msg_mini_writer::write_int(int32_t i)
+	{
+		uint8_t marker = 0;
+		if (i >= 0) {
+			if (i <= 0x7F) {
+				marker = (uint8_t)i;
+				write_bytes(&marker, sizeof(uint8_t));
+			}
+			else if (i <= 0xFF) {
+				marker = U8_MARKER;
+				uint8_t val = (uint8_t)i;
+				write_bytes(&marker, sizeof(uint8_t));
+				write_bytes(&val, sizeof(uint8_t));
+			}
+			else if (i <= 0xFFFF) {
+				marker = U16_MARKER;
+				uint16_t val = be16((uint16_t)i);
+				write_bytes(&marker, sizeof(uint8_t));
+				write_bytes(&val, sizeof(uint16_t));
+			}
+			else {
+				marker = U32_MARKER;
+				uint32_t val = be32((uint32_t)i);
+				write_bytes(&marker, sizeof(uint8_t));
+				write_bytes(&val, sizeof(uint32_t));
+			}
+		}
+		else {
+			if (i >= -32) {
+				marker = (uint8_t)(int8_t)i;
+				write_bytes(&marker, sizeof(uint8_t));
+			}
+			else if (i >= -128) {
+				marker = S8_MARKER;
+				int8_t val = (int8_t)i;
+				write_bytes(&marker, sizeof(uint8_t));
+				write_bytes(&val, sizeof(int8_t));
+			}
+			else if (i >= -32768) {
+				marker = S16_MARKER;
+				uint16_t val = be16((uint16_t)(int16_t)i);
+				write_bytes(&marker, sizeof(uint8_t));
+				write_bytes(&val, sizeof(uint16_t));
+			}
+			else {
+				marker = S32_MARKER;
+				uint32_t val = be32((uint32_t)i);
+				write_bytes(&marker, sizeof(uint8_t));
+				write_bytes(&val, sizeof(uint32_t));
+			}
+		}
+	}
+
+	void 
+	msg_mini_writer::write_float(float f)
+	{
+		uint8_t marker = FLOAT_MARKER;
+		float val = befloat(f);
+		write_bytes(&marker, sizeof(uint8_t));
+		write_bytes(&val, sizeof(float));
+	}
+
+	void 
+	msg_mini_writer::write_str(const std::string& data)
+	{
+		uint8_t marker = 0;
+		uint32_t size = (uint32_t)data.size();
+		if (size <= FIXSTR_SIZE) {
+			marker = (uint8_t)(FIXSTR_MARKER | size);
+			write_bytes(&marker, sizeof(uint8_t));
+		}
+		else if (size <= 0xFF) {
+			marker = STR8_MARKER;
+			uint8_t val = (uint8_t)size;
+			write_bytes(&marker, sizeof(uint8_t));
+			write_bytes(&val, sizeof(uint8_t));
+		}
+		else if (size <= 0xFFFF) {
+			marker = STR16_MARKER;
+			uint16_t val = be16((uint16_t)size);
+			write_bytes(&marker, sizeof(uint8_t));
+			write_bytes(&val, sizeof(uint16_t));
+		}
+		else {
+			marker = STR32_MARKER;
+			uint32_t val = be32(size);
+			write_bytes(&marker, sizeof(uint8_t));
+			write_bytes(&val, sizeof(uint32_t));
+		}
+
+		write_bytes(data.data(), data.size());
+	}
+
+	void 
+	msg_mini_writer::write_short_bin(const std::vector<int16_t>& data)
+	{
+		uint8_t marker = 0;
+		uint32_t size = (uint32_t)data.size() * 2;
+		if (size <= 0xFF) {
+			marker = BIN8_MARKER;
+			uint8_t val = (uint8_t)size;
+			write_bytes(&marker, sizeof(uint8_t));
+			write_bytes(&val, sizeof(uint8_t));
+		}
+		else if (size <= 0xFFFF) {
+			marker = BIN16_MARKER;
+			uint16_t val = be16((uint16_t)size);
+			write_bytes(&marker, sizeof(uint8_t));
+			write_bytes(&val, sizeof(uint16_t));
+		}
+		else {
+			marker = BIN32_MARKER;
+			uint32_t val = be32(size);
+			write_bytes(&marker, sizeof(uint8_t));
+			write_bytes(&val, sizeof(uint32_t));
+		}
+
+		for (auto cur_val : data)
+		{
+			uint8_t bytes[2] = { (uint8_t)((uint16_t)cur_val & 0xFF), (uint8_t)((uint16_t)cur_val >> 8) };
+			write_bytes(bytes, sizeof(bytes));
+		}
+	}
+
+	void 
+	msg_mini_writer::write_int_array(const std::vector<int32_t>& data)
+	{
+		write_array_size((uint32_t)data.size());
+		for (auto cur_val : data)
+		{
+			write_int(cur_val);
+		}
+	}
+
+	void 
+	msg_mini_writer::write_float_array(const std::vector<float>& data)
+	{
+		write_array_size((uint32_t)data.size());
+		for (auto cur_val : data)
+		{
+			write_float(cur_val);
+		}
+	}
+
+	void 
+	msg_mini_writer::write_str_array(const std::vector<std::string>& data)
+	{
+		write_array_size((uint32_t)data.size());
+		for (auto& cur_val : data)
+		{
+			write_str(cur_val);
+		}
+	}
+
+	void 
+	msg_mini_writer::write_generic(const msg_mini_generic_data& data)
+	{
+		switch (data.type) {
+		case MSG_MINI_GENERIC_INT_TYPE:
+			write_int(data.int_val);
+			break;
+		case MSG_MINI_GENERIC_FLOAT_TYPE:
+			write_float(data.float_val);
+			break;
+		case MSG_MINI_GENERIC_STRING_TYPE:
+			write_str(data.string_val);
+			break;
+		case MSG_MINI_GENERIC_ARRAY_INT_TYPE:
+			write_int_array(data.int_array_val);
+			break;
+		case MSG_MINI_GENERIC_ARRAY_FLOAT_TYPE:
+			write_float_array(data.float_array_val);
+			break;
+		case MSG_MINI_GENERIC_ARRAY_STRING_TYPE:
+			write_str_array(data.str_array_val);
+			break;
+		case MSG_MINI_GENERIC_ARRAY_SHORT_TYPE:
+			write_short_bin(data.short_array_val);
+			break;
+		case MSG_MINI_GENERIC_ARRAY_EMPTY_TYPE:
+			write_array_size(0);
+			break;
+		default:
+			// every object has to be written, or the size of the enclosing array is wrong
+			assert(false);
+			break;
+		}
+	}
 }
\ No newline at end of file
@@ -15,6 +15,14 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Creature")
 	UMaterialInterface * collection_material;
 
+	/** Re-encodes the pack on import with int16 points, keyframe reduction and change only uv/color streams */
+	UPROPERTY(EditAnywhere, Category = "ImportSettings")
+	bool quantize_on_import = false;
+
+	/** Max point error allowed when dropping keyframes from a quantized pack, 0 keeps every keyframe */
+	UPROPERTY(EditAnywhere, Category = "ImportSettings")
+	float keyframe_error_tolerance = 0.0f;
+
 	// Zip Binary Data
 	UPROPERTY()
 	TArray<uint8> CreatureZipBinary;
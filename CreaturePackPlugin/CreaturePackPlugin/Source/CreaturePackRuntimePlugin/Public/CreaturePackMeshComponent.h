@@ -74,6 +74,14 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature")
 	float region_offset_z;
 
+	/** Shares decoded animation frames with other components playing the same clip at the same time. Good for crowds. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|CreaturePack")
+	bool use_shared_frame_cache;
+
+	/** Playback times are snapped to this step when using the shared frame cache, 0 only shares identical times */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|CreaturePack")
+	float shared_frame_cache_time_step;
+
 	// Blueprint version of setting the active animation name
 	UFUNCTION(BlueprintCallable, Category = "Components|CreaturePack")
 	void SetActiveAnimation(FString name_in);
@@ -33,6 +33,8 @@
 * RUNTIMES.
 *****************************************************************************/
 
+#pragma once
+
 #include "CreaturePackRuntimePluginPCH.h"
 #include "mp.h"
 #include <string>
@@ -42,6 +44,9 @@
 #include <memory>
 #include <array>
 #include <stack>
+#include <mutex>
+#include <functional>
+#include <cstring>
 
 class CreatureTimeSample
 {
@@ -57,6 +62,8 @@ public:
         beginTime = beginTimeIn;
         endTime = endTimeIn;
         dataIdx = dataIdxIn;
+		uvsDataIdx = (dataIdx < 0) ? -1 : dataIdx + 2;
+		colorsDataIdx = (dataIdx < 0) ? -1 : dataIdx + 3;
     }
     
     virtual ~CreatureTimeSample() {}
@@ -78,7 +85,7 @@ public:
 			return -1; // invalid
 		}
 		
-		return dataIdx + 2;
+		return uvsDataIdx;
 	}
 	
 	int32 getAnimColorsOffset()
@@ -88,12 +95,14 @@ public:
 			return -1; // invalid
 		}
 		
-		return dataIdx + 3;
+		return colorsDataIdx;
 	}
 
     int32 beginTime;
     int32 endTime;
     int32 dataIdx;
+	// Quantized packs only store uvs/colors when they change so these can point back to an earlier sample
+	int32 uvsDataIdx, colorsDataIdx;
 };
 
 class CreaturePackSampleData {
@@ -129,8 +138,42 @@ public:
 		startTime = 0;
 		endTime = 0;
 		firstSet = false;
+		hasUvs = false;
+		hasColors = false;
+		uvsAnimated = false;
+		colorsAnimated = false;
+		quantized = false;
+		quantOffset[0] = quantOffset[1] = 0.0f;
+		quantScale[0] = quantScale[1] = 1.0f;
     }
 
+	// Sets up the decoding of int16 points from the clip bounds: [min_x, min_y, max_x, max_y]
+	void setQuantization(const std::vector<float>& boundsIn)
+	{
+		if (boundsIn.size() < 4)
+		{
+			return;
+		}
+
+		quantized = true;
+		for (int32 i = 0; i < 2; i++)
+		{
+			quantOffset[i] = boundsIn[i];
+			quantScale[i] = (boundsIn[i + 2] - boundsIn[i]) / 65535.0f;
+		}
+	}
+
+	// Reads back a single x or y point value from a sample's points array
+	float readPoint(const mpMini::msg_mini_generic_data& pointsIn, size_t idx) const
+	{
+		if (quantized)
+		{
+			return quantOffset[idx & 1] + ((float)pointsIn.short_array_val[idx] + 32768.0f) * quantScale[idx & 1];
+		}
+
+		return pointsIn.float_array_val[idx];
+	}
+
 	CreaturePackSampleData sampleTime(float timeIn) const
 	{
 		int32 lookupTime = (int32)(roundf(timeIn));
@@ -230,10 +273,73 @@ public:
 		}		
 	}
 
+	// Points samples with identical uvs/colors at the same data and flags whether the clip has/changes those streams
+	void finalStreamSamples(const std::vector<mpMini::msg_mini_generic_data>& fileData)
+	{
+		std::vector<int32> sorted_keys;
+		for (auto& curData : timeSamplesMap)
+		{
+			if (curData.second.dataIdx >= 0)
+			{
+				sorted_keys.push_back(curData.first);
+			}
+		}
+
+		std::sort(sorted_keys.begin(), sorted_keys.end(), sortArrayNum);
+
+		CreatureTimeSample * prevSample = nullptr;
+		for (auto curTime : sorted_keys)
+		{
+			auto& curSample = timeSamplesMap[curTime];
+			if ((curSample.uvsDataIdx >= 0) && !fileData[curSample.uvsDataIdx].float_array_val.empty())
+			{
+				hasUvs = true;
+			}
+
+			if ((curSample.colorsDataIdx >= 0) && !fileData[curSample.colorsDataIdx].int_array_val.empty())
+			{
+				hasColors = true;
+			}
+
+			if (prevSample)
+			{
+				if (curSample.uvsDataIdx != prevSample->uvsDataIdx)
+				{
+					if ((curSample.uvsDataIdx >= 0) && (prevSample->uvsDataIdx >= 0)
+						&& (fileData[curSample.uvsDataIdx].float_array_val == fileData[prevSample->uvsDataIdx].float_array_val))
+					{
+						curSample.uvsDataIdx = prevSample->uvsDataIdx;
+					}
+					else {
+						uvsAnimated = true;
+					}
+				}
+
+				if (curSample.colorsDataIdx != prevSample->colorsDataIdx)
+				{
+					if ((curSample.colorsDataIdx >= 0) && (prevSample->colorsDataIdx >= 0)
+						&& (fileData[curSample.colorsDataIdx].int_array_val == fileData[prevSample->colorsDataIdx].int_array_val))
+					{
+						curSample.colorsDataIdx = prevSample->colorsDataIdx;
+					}
+					else {
+						colorsAnimated = true;
+					}
+				}
+			}
+
+			prevSample = &curSample;
+		}
+	}
+
     int32 startTime, endTime;
     std::unordered_map<int32, CreatureTimeSample> timeSamplesMap;
     int32 dataIdx;
     bool firstSet;
+	bool hasUvs, hasColors;
+	bool uvsAnimated, colorsAnimated;
+	bool quantized;
+	float quantOffset[2], quantScale[2];
 };
 
 // This is the class the loads in Creature Pack Data from disk
@@ -337,6 +443,17 @@ public:
 	{
 		return fileData.at(getBaseUvsOffset()).float_array_val.size();
 	}
+
+	// Packs re-encoded by CreaturePackQuantizer tag themselves in the header list
+	bool isQuantized() const
+	{
+		return std::find(headerList.begin(), headerList.end(), getQuantizedTag()) != headerList.end();
+	}
+
+	static const char * getQuantizedTag()
+	{
+		return "quantized";
+	}
   
     std::shared_ptr<uint32> indices;
     std::shared_ptr<float> uvs;
@@ -367,6 +484,7 @@ protected:
 		updateUVs(getBaseUvsOffset());
 		
 		// init Animation Clip Map		
+		const bool quantizedFormat = isQuantized();
 		for (size_t i = 0; i < getAnimationNum(); i++)
 		{
 			const auto& curOffsetPair = getAnimationOffsets(i);
@@ -374,17 +492,49 @@ protected:
 			auto animName = fileData[curOffsetPair.first].string_val;
 			auto k = curOffsetPair.first ;
 			k++;
+
+			// quantized clips store their bounds right after the name
+			const std::vector<float>& clipBounds = fileData[k].float_array_val;
+			if (quantizedFormat)
+			{
+				k++;
+			}
+
 			CreaturePackAnimClip newClip(k);
-				
+			if (quantizedFormat)
+			{
+				newClip.setQuantization(clipBounds);
+			}
+
+			int32 lastUvsIdx = -1, lastColorsIdx = -1;
 			while(k < curOffsetPair.second)
 			{
 				int32 cur_time = fileData[k].float_val;
 				newClip.addTimeSample(cur_time, (int32)k);
+
+				if (quantizedFormat)
+				{
+					// empty uvs/colors mean unchanged from the previous sample
+					if (!fileData[k + 2].float_array_val.empty())
+					{
+						lastUvsIdx = k + 2;
+					}
+
+					if (!fileData[k + 3].int_array_val.empty())
+					{
+						lastColorsIdx = k + 3;
+					}
+
+					auto& curSample = newClip.timeSamplesMap[cur_time];
+					curSample.uvsDataIdx = lastUvsIdx;
+					curSample.colorsDataIdx = lastColorsIdx;
+				}
 					
 				k += 4;
 			}
 				
 			newClip.finalTimeSamples();
+			newClip.finalStreamSamples(fileData);
             animClipMap[animName] = newClip;
 		}
 
@@ -501,17 +651,166 @@ protected:
 	}
 };
 
+// Shares fully interpolated clip frames between players of the same loader and clip at the same (quantized) time.
+// Frames are reference counted through their shared_ptr so frames still held by a player are never evicted.
+class CreaturePackFrameCache {
+public:
+	CreaturePackFrameCache(size_t maxFramesIn = 64)
+	{
+		maxFrames = maxFramesIn;
+		useCounter = 0;
+	}
+
+	virtual ~CreaturePackFrameCache() {}
+
+	typedef std::shared_ptr<const std::vector<float>> FramePtr;
+
+	// Returns the cached frame for the key, calling buildFunc to create it if missing.
+	// Returns nullptr if the cache is full of frames that are still in use.
+	FramePtr getFrame(
+		const CreaturePackLoader * loaderIn,
+		const CreaturePackAnimClip * clipIn,
+		float quantTimeIn,
+		const std::function<void(std::vector<float>&)>& buildFunc)
+	{
+		std::lock_guard<std::mutex> scope_lock(cacheLock);
+		useCounter++;
+
+		for (auto& curFrame : frames)
+		{
+			if ((curFrame.loader == loaderIn) && (curFrame.clip == clipIn) && (curFrame.quantTime == quantTimeIn))
+			{
+				curFrame.lastUsed = useCounter;
+				return curFrame.data;
+			}
+		}
+
+		CachedFrame * writeFrame = nullptr;
+		if (frames.size() < maxFrames)
+		{
+			frames.push_back(CachedFrame());
+			writeFrame = &frames.back();
+		}
+		else {
+			// evict the least recently used frame nobody else is holding on to
+			for (auto& curFrame : frames)
+			{
+				if ((curFrame.data.use_count() <= 1)
+					&& ((writeFrame == nullptr) || (curFrame.lastUsed < writeFrame->lastUsed)))
+				{
+					writeFrame = &curFrame;
+				}
+			}
+		}
+
+		if (writeFrame == nullptr)
+		{
+			return nullptr;
+		}
+
+		std::shared_ptr<std::vector<float>> newData(new std::vector<float>());
+		buildFunc(*newData);
+
+		writeFrame->loader = loaderIn;
+		writeFrame->clip = clipIn;
+		writeFrame->quantTime = quantTimeIn;
+		writeFrame->lastUsed = useCounter;
+		writeFrame->data = newData;
+
+		return writeFrame->data;
+	}
+
+	static float quantizeTime(float timeIn, float timeStep)
+	{
+		if (timeStep <= 0)
+		{
+			return timeIn;
+		}
+
+		return roundf(timeIn / timeStep) * timeStep;
+	}
+
+	void clear()
+	{
+		std::lock_guard<std::mutex> scope_lock(cacheLock);
+		frames.clear();
+	}
+
+protected:
+	class CachedFrame {
+	public:
+		CachedFrame()
+		{
+			loader = nullptr;
+			clip = nullptr;
+			quantTime = 0;
+			lastUsed = 0;
+		}
+
+		const CreaturePackLoader * loader;
+		const CreaturePackAnimClip * clip;
+		float quantTime;
+		uint64_t lastUsed;
+		FramePtr data;
+	};
+
+	std::vector<CachedFrame> frames;
+	size_t maxFrames;
+	uint64_t useCounter;
+	std::mutex cacheLock;
+};
+
+// A single clip playing inside the CreaturePackPlayer blend stack
+class CreaturePackBlendEntry {
+public:
+	CreaturePackBlendEntry()
+	{
+		clip = nullptr;
+		runTime = 0;
+		weight = 0;
+		baseWeight = 0;
+	}
+
+	CreaturePackBlendEntry(CreaturePackAnimClip * clipIn, const std::string& nameIn, float runTimeIn, float weightIn)
+	{
+		clip = clipIn;
+		name = nameIn;
+		runTime = runTimeIn;
+		weight = weightIn;
+		baseWeight = weightIn;
+	}
+
+	CreaturePackAnimClip * clip;
+	std::string name;
+	float runTime;
+	// weight is the current blend weight, baseWeight the weight it had when the newest entry was pushed
+	float weight, baseWeight;
+};
+
 // Base Player class that target renderers use
 class CreaturePackPlayer {
 public:
+	// Max number of clips that can be blended together at once
+	static const int32 maxBlendEntries = 4;
+
     CreaturePackPlayer(CreaturePackLoader& dataIn)
         : data(dataIn)
     {
+		blendEntriesNum = 0;
+		frameCache = nullptr;
+		frameCacheTimeStep = 0;
         createRuntimeMap();
 		isPlaying = true;
 		isLooping = true;
 		animBlendFactor = 0;
 		animBlendDelta = 0;
+		uvsChanged = true;
+		lastUvsIdx = -1;
+		lastColorsLowIdx = -1;
+		lastColorsHighIdx = -1;
+		lastColorsFraction = 0;
+		lastUvsClip = nullptr;
+		lastColorsClip = nullptr;
 				
 		// create data buffers
         renders_base_size = data.getNumPoints() / 2;
@@ -555,6 +854,8 @@ public:
 				firstSet = true;
 				activeAnimationName = animName;
 				prevAnimationName = animName;
+				blendEntries[0] = CreaturePackBlendEntry(&curData.second, animName, (float)curData.second.startTime, 1.0f);
+				blendEntriesNum = 1;
 			}
 			
 			auto animClip = data.animClipMap.at(animName);
@@ -570,7 +871,12 @@ public:
 		{
 			activeAnimationName = nameIn;
 			prevAnimationName = nameIn;
-            runTimeMap[activeAnimationName] = data.animClipMap[activeAnimationName].startTime;
+			auto& activeClip = data.animClipMap[activeAnimationName];
+            runTimeMap[activeAnimationName] = activeClip.startTime;
+
+			blendEntries[0] = CreaturePackBlendEntry(&activeClip, nameIn, (float)activeClip.startTime, 1.0f);
+			blendEntriesNum = 1;
+			animBlendFactor = 0;
             
             return true;
 		}
@@ -578,39 +884,83 @@ public:
         return false;
 	}
 	
-	// Smoothly blends to a target animation
+	// Smoothly blends to a target animation. blendDelta is the blend amount per unit of time.
+	// Starting a new blend while one is running keeps the current pose blending out instead of snapping.
 	void blendToAnimation(const std::string& nameIn, float blendDelta)
 	{
 		if (runTimeMap.count(nameIn) > 0) {
+			// The current weights become the weights blended out from
+			for (int32 i = 0; i < blendEntriesNum; i++)
+			{
+				blendEntries[i].baseWeight = blendEntries[i].weight;
+			}
+
+			if (blendEntriesNum >= maxBlendEntries)
+			{
+				removeLightestBlendEntry();
+			}
+
 			prevAnimationName = activeAnimationName;
 			activeAnimationName = nameIn;
 			animBlendFactor = 0;
 			animBlendDelta = blendDelta;
 
-			runTimeMap[activeAnimationName] = data.animClipMap[activeAnimationName].startTime;
+			auto& activeClip = data.animClipMap[activeAnimationName];
+			runTimeMap[activeAnimationName] = activeClip.startTime;
+
+			blendEntries[blendEntriesNum] = CreaturePackBlendEntry(&activeClip, nameIn, (float)activeClip.startTime, 0.0f);
+			blendEntriesNum++;
 		}
 	}
 
 	void setRunTime(float timeIn)
 	{	
-		runTimeMap[activeAnimationName] = data.animClipMap[activeAnimationName].correctTime(timeIn, isLooping);
+		if (blendEntriesNum == 0)
+		{
+			// pack without clips
+			return;
+		}
+
+		auto& activeEntry = getActiveBlendEntry();
+		activeEntry.runTime = activeEntry.clip->correctTime(timeIn, isLooping);
+		runTimeMap[activeAnimationName] = activeEntry.runTime;
 	}
 	
 	float getRunTime() const
 	{
-		return runTimeMap.at(activeAnimationName);
+		return (blendEntriesNum > 0) ? blendEntries[blendEntriesNum - 1].runTime : 0.0f;
 	}
 	
 	// Steps the animation by a delta time
 	void stepTime(float deltaTime)
 	{
+		if (blendEntriesNum == 0)
+		{
+			return;
+		}
+
+		for (int32 i = 0; i < blendEntriesNum - 1; i++)
+		{
+			auto& curEntry = blendEntries[i];
+			curEntry.runTime = curEntry.clip->correctTime(curEntry.runTime + deltaTime, isLooping);
+		}
+
 		setRunTime(getRunTime() + deltaTime);
 		
 		// update blending
-		animBlendFactor += animBlendDelta;
-		if (animBlendFactor > 1)
+		if (blendEntriesNum > 1)
 		{
-			animBlendFactor = 1;
+			animBlendFactor += animBlendDelta * deltaTime;
+			if (animBlendFactor >= 1)
+			{
+				// blend is done so only the active clip remains
+				animBlendFactor = 1;
+				blendEntries[0] = getActiveBlendEntry();
+				blendEntriesNum = 1;
+				prevAnimationName = activeAnimationName;
+			}
+
+			updateBlendWeights();
 		}
 	}
 	
@@ -618,110 +968,153 @@ public:
 	{
 		return ((1.0 - fraction) * val1) + (fraction * val2);
 	}
+
+	int32 getBlendEntriesNum() const
+	{
+		return blendEntriesNum;
+	}
+
+	const CreaturePackBlendEntry& getBlendEntry(int32 idx) const
+	{
+		return blendEntries[idx];
+	}
+
+	// Opt-in: share interpolated frames with other players through cacheIn, times are snapped to timeStep
+	void setFrameCache(CreaturePackFrameCache * cacheIn, float timeStep)
+	{
+		frameCache = cacheIn;
+		frameCacheTimeStep = timeStep;
+		if (frameCache == nullptr)
+		{
+			cachedFrame.reset();
+		}
+	}
 	
 	// Call this before a render to update the render data
 	void syncRenderData() { 
+	if (blendEntriesNum == 0)
 	{
-		// Points blending
-		if (activeAnimationName == prevAnimationName)
+		// pack without clips, the render data stays at the base mesh
+		uvsChanged = false;
+		return;
+	}
+
+	{
+		// Points blending, all blend entries are interpolated and blended in a single pass
+		std::array<BlendSample, maxBlendEntries> blend_samples;
+		int32 blend_num = 0;
+		for (int32 k = 0; k < blendEntriesNum; k++)
 		{
-			auto& cur_clip = data.animClipMap[activeAnimationName];
-			// no blending
-			auto cur_clip_info = cur_clip.sampleTime(getRunTime());
-			CreatureTimeSample& low_data = cur_clip.timeSamplesMap[cur_clip_info.firstSampleIdx];
-			CreatureTimeSample& high_data = cur_clip.timeSamplesMap[cur_clip_info.secondSampleIdx];
-			
-			std::vector<float>& anim_low_points = data.fileData[low_data.getAnimPointsOffset()].float_array_val;
-			std::vector<float>& anim_high_points = data.fileData[high_data.getAnimPointsOffset()].float_array_val;
-			
-			for (auto i = 0; i < renders_base_size; i++)
+			auto& cur_entry = blendEntries[k];
+			if ((cur_entry.weight <= 0) && (blendEntriesNum > 1))
 			{
-                for(auto j = 0; j < 2; j++)
-                {
-                    auto low_val = anim_low_points[i * 2 + j];
-                    auto high_val = anim_high_points[i * 2 + j];
-                    render_points.get()[i * 3 + j] = interpScalar(low_val, high_val, cur_clip_info.sampleFraction);                    
-                }
-                
-                render_points.get()[i * 3 + 2] = 0.0f;
+				continue;
 			}
+
+			fillBlendSample(blend_samples[blend_num], *cur_entry.clip, cur_entry.runTime, (blendEntriesNum > 1) ? cur_entry.weight : 1.0f);
+			blend_num++;
 		}
-		else {
-			// blending
-			
-			// Active Clip
-			auto& active_clip =  data.animClipMap[activeAnimationName];
-			
-			auto active_clip_info = active_clip.sampleTime(getRunTime());
-			CreatureTimeSample& active_low_data = active_clip.timeSamplesMap[active_clip_info.firstSampleIdx];
-			CreatureTimeSample& active_high_data = active_clip.timeSamplesMap[active_clip_info.secondSampleIdx];
-			
-			std::vector<float>& active_anim_low_points = data.fileData[active_low_data.getAnimPointsOffset()].float_array_val;
-			std::vector<float>& active_anim_high_points = data.fileData[active_high_data.getAnimPointsOffset()].float_array_val;
-			
-			// Previous Clip
-			auto& prev_clip =  data.animClipMap[prevAnimationName];
-			
-			auto prev_clip_info = prev_clip.sampleTime(getRunTime());
-			CreatureTimeSample& prev_low_data = prev_clip.timeSamplesMap[prev_clip_info.firstSampleIdx];
-			CreatureTimeSample& prev_high_data = prev_clip.timeSamplesMap[prev_clip_info.secondSampleIdx];
-			
-			std::vector<float>& prev_anim_low_points = data.fileData[prev_low_data.getAnimPointsOffset()].float_array_val;
-			std::vector<float>& prev_anim_high_points = data.fileData[prev_high_data.getAnimPointsOffset()].float_array_val;
 
-			for (auto i = 0; i < renders_base_size; i++)
+		bool points_done = false;
+		if (frameCache && (blend_num == 1))
+		{
+			// Single clip playback can come straight out of the shared frame cache
+			auto& cur_entry = getActiveBlendEntry();
+			const float quant_time = CreaturePackFrameCache::quantizeTime(cur_entry.runTime, frameCacheTimeStep);
+			const size_t points_length = getRenderPointsLength();
+			cachedFrame = frameCache->getFrame(&data, cur_entry.clip, quant_time,
+				[this, &cur_entry, quant_time, points_length](std::vector<float>& frameOut)
+			{
+				BlendSample quant_sample;
+				fillBlendSample(quant_sample, *cur_entry.clip, quant_time, 1.0f);
+				frameOut.resize(points_length);
+				blendPoints(&quant_sample, 1, frameOut.data());
+			});
+
+			if (cachedFrame && (cachedFrame->size() == points_length))
 			{
-                for(auto j = 0; j < 2; j++)
-                {
-                    auto active_low_val = active_anim_low_points[i * 2 + j];
-                    auto active_high_val = active_anim_high_points[i * 2 + j];
-                    auto active_val =  interpScalar(active_low_val, active_high_val, active_clip_info.sampleFraction);
-
-                    auto prev_low_val = prev_anim_low_points[i * 2 + j];
-                    auto prev_high_val = prev_anim_high_points[i * 2 + j];
-                    auto prev_val =  interpScalar(prev_low_val, prev_high_val, prev_clip_info.sampleFraction);
-
-                    render_points.get()[i * 3 + j] = interpScalar(prev_val, active_val, animBlendFactor);
-                }
-                
-                render_points.get()[i * 3 + 2] = 0.0f;
+				std::memcpy(render_points.get(), cachedFrame->data(), points_length * sizeof(float));
+				points_done = true;
 			}
 		}
+		else {
+			cachedFrame.reset();
+		}
+
+		if (!points_done)
+		{
+			blendPoints(blend_samples.data(), blend_num, render_points.get());
+		}
 		
 		// Colors
 		{
-			auto& cur_clip =  data.animClipMap[activeAnimationName];
-			// no blending
-			auto cur_clip_info = cur_clip.sampleTime(getRunTime());
-			CreatureTimeSample& low_data = cur_clip.timeSamplesMap[cur_clip_info.firstSampleIdx];
-			CreatureTimeSample& high_data = cur_clip.timeSamplesMap[cur_clip_info.secondSampleIdx];
+			auto& cur_clip = *getActiveBlendEntry().clip;
+			// Clips with static colors only need to be sampled once
+			if (cur_clip.hasColors && (cur_clip.colorsAnimated || (&cur_clip != lastColorsClip)))
+			{
+				// no blending
+				auto cur_clip_info = cur_clip.sampleTime(getRunTime());
+				CreatureTimeSample& low_data = cur_clip.timeSamplesMap[cur_clip_info.firstSampleIdx];
+				CreatureTimeSample& high_data = cur_clip.timeSamplesMap[cur_clip_info.secondSampleIdx];
 			
-			std::vector<int32_t>& anim_low_colors = data.fileData[low_data.getAnimColorsOffset()].int_array_val;
-			std::vector<int32_t>& anim_high_colors = data.fileData[high_data.getAnimColorsOffset()].int_array_val;
+				const int32 low_colors_offset = low_data.getAnimColorsOffset();
+				const int32 high_colors_offset = high_data.getAnimColorsOffset();
+				// Identical low and high colors do not depend on the sample fraction
+				const float colors_fraction = (low_colors_offset == high_colors_offset) ? 0.0f : cur_clip_info.sampleFraction;
 			
-			if((anim_low_colors.size() == getRenderColorsLength())
-				&& (anim_high_colors.size() == getRenderColorsLength())) {
-				for (size_t i = 0; i < (size_t)getRenderColorsLength(); i++)
+				if ((low_colors_offset >= 0) && (high_colors_offset >= 0)
+					&& ((low_colors_offset != lastColorsLowIdx) || (high_colors_offset != lastColorsHighIdx) || (colors_fraction != lastColorsFraction)))
 				{
-				    float low_val = (float)anim_low_colors[i];
-					float high_val = (float)anim_high_colors[i];
-					render_colors.get()[i] = (uint8_t)interpScalar(low_val, high_val, cur_clip_info.sampleFraction);
+					std::vector<int32_t>& anim_low_colors = data.fileData[low_colors_offset].int_array_val;
+					std::vector<int32_t>& anim_high_colors = data.fileData[high_colors_offset].int_array_val;
+				
+					if((anim_low_colors.size() == getRenderColorsLength())
+						&& (anim_high_colors.size() == getRenderColorsLength())) {
+						for (size_t i = 0; i < (size_t)getRenderColorsLength(); i++)
+						{
+						    float low_val = (float)anim_low_colors[i];
+							float high_val = (float)anim_high_colors[i];
+							render_colors.get()[i] = (uint8_t)interpScalar(low_val, high_val, colors_fraction);
+						}
+					}
+
+					lastColorsLowIdx = low_colors_offset;
+					lastColorsHighIdx = high_colors_offset;
+					lastColorsFraction = colors_fraction;
 				}
+
+				lastColorsClip = &cur_clip;
 			}
 		}
 	
 			// UVs
 			{
-				auto& cur_clip =  data.animClipMap[activeAnimationName];
-				auto cur_clip_info = cur_clip.sampleTime(getRunTime());
-				CreatureTimeSample& low_data = cur_clip.timeSamplesMap[cur_clip_info.firstSampleIdx];
-				std::vector<float>& anim_uvs = data.fileData[low_data.getAnimUvsOffset()].float_array_val;
-				if (anim_uvs.size() == getRenderUVsLength())
+				auto& cur_clip = *getActiveBlendEntry().clip;
+				uvsChanged = false;
+				// Clips with static uvs only need to be sampled once
+				if (cur_clip.hasUvs && (cur_clip.uvsAnimated || (&cur_clip != lastUvsClip)))
 				{
-					for (size_t i = 0; i < (size_t)getRenderUVsLength(); i++)
+					auto cur_clip_info = cur_clip.sampleTime(getRunTime());
+					CreatureTimeSample& low_data = cur_clip.timeSamplesMap[cur_clip_info.firstSampleIdx];
+					const int32 uvs_offset = low_data.getAnimUvsOffset();
+
+					if ((uvs_offset >= 0) && (uvs_offset != lastUvsIdx))
 					{
-						render_uvs.get()[i] = anim_uvs[i];
+						std::vector<float>& anim_uvs = data.fileData[uvs_offset].float_array_val;
+						if (anim_uvs.size() == getRenderUVsLength())
+						{
+							for (size_t i = 0; i < (size_t)getRenderUVsLength(); i++)
+							{
+								render_uvs.get()[i] = anim_uvs[i];
+							}
+
+							uvsChanged = true;
+						}
+
+						lastUvsIdx = uvs_offset;
 					}
+
+					lastUvsClip = &cur_clip;
 				}
 			}		
 		}
@@ -739,4 +1132,116 @@ public:
     
     std::string activeAnimationName, prevAnimationName;
     float animBlendFactor, animBlendDelta;
+
+	// Set by syncRenderData() when render_uvs were rewritten that frame, the mesh attributes only carry uvs and region alphas
+	bool uvsChanged;
+
+protected:
+	struct BlendSample {
+		const CreaturePackAnimClip * clip;
+		const mpMini::msg_mini_generic_data * lowPoints;
+		const mpMini::msg_mini_generic_data * highPoints;
+		float fraction;
+		float weight;
+	};
+
+	void fillBlendSample(BlendSample& sampleOut, CreaturePackAnimClip& clipIn, float timeIn, float weightIn)
+	{
+		auto cur_clip_info = clipIn.sampleTime(timeIn);
+		CreatureTimeSample& low_data = clipIn.timeSamplesMap[cur_clip_info.firstSampleIdx];
+		CreatureTimeSample& high_data = clipIn.timeSamplesMap[cur_clip_info.secondSampleIdx];
+
+		sampleOut.clip = &clipIn;
+		sampleOut.lowPoints = &data.fileData[low_data.getAnimPointsOffset()];
+		sampleOut.highPoints = &data.fileData[high_data.getAnimPointsOffset()];
+		sampleOut.fraction = cur_clip_info.sampleFraction;
+		sampleOut.weight = weightIn;
+	}
+
+	// Interpolates and weights all samples into a xyz points array in one pass
+	void blendPoints(const BlendSample * samplesIn, int32 samplesNum, float * pointsOut)
+	{
+		for (auto i = 0; i < renders_base_size; i++)
+		{
+            for(auto j = 0; j < 2; j++)
+            {
+				const size_t read_idx = i * 2 + j;
+				float blend_val = 0;
+				for (int32 k = 0; k < samplesNum; k++)
+				{
+					const auto& cur_sample = samplesIn[k];
+					auto low_val = cur_sample.clip->readPoint(*cur_sample.lowPoints, read_idx);
+					auto high_val = cur_sample.clip->readPoint(*cur_sample.highPoints, read_idx);
+					blend_val += cur_sample.weight * interpScalar(low_val, high_val, cur_sample.fraction);
+				}
+
+				pointsOut[i * 3 + j] = blend_val;
+            }
+            
+            pointsOut[i * 3 + 2] = 0.0f;
+		}
+	}
+
+	// Packs without clips have no entries, blendEntries[0] then stays an empty entry without a clip
+	CreaturePackBlendEntry& getActiveBlendEntry()
+	{
+		return blendEntries[(blendEntriesNum > 0) ? (blendEntriesNum - 1) : 0];
+	}
+
+	void updateBlendWeights()
+	{
+		for (int32 i = 0; i < blendEntriesNum - 1; i++)
+		{
+			blendEntries[i].weight = blendEntries[i].baseWeight * (1.0f - animBlendFactor);
+		}
+
+		getActiveBlendEntry().weight = (blendEntriesNum > 1) ? animBlendFactor : 1.0f;
+	}
+
+	// Makes room in a full blend stack by dropping the entry contributing the least
+	void removeLightestBlendEntry()
+	{
+		int32 removeIdx = 0;
+		for (int32 i = 1; i < blendEntriesNum; i++)
+		{
+			if (blendEntries[i].baseWeight < blendEntries[removeIdx].baseWeight)
+			{
+				removeIdx = i;
+			}
+		}
+
+		for (int32 i = removeIdx; i < blendEntriesNum - 1; i++)
+		{
+			blendEntries[i] = blendEntries[i + 1];
+		}
+
+		blendEntriesNum--;
+
+		float weightSum = 0;
+		for (int32 i = 0; i < blendEntriesNum; i++)
+		{
+			weightSum += blendEntries[i].baseWeight;
+		}
+
+		for (int32 i = 0; i < blendEntriesNum; i++)
+		{
+			blendEntries[i].baseWeight = (weightSum > 0) ? (blendEntries[i].baseWeight / weightSum) : (1.0f / blendEntriesNum);
+			blendEntries[i].weight = blendEntries[i].baseWeight;
+		}
+	}
+
+	std::array<CreaturePackBlendEntry, maxBlendEntries> blendEntries;
+	int32 blendEntriesNum;
+
+	CreaturePackFrameCache * frameCache;
+	float frameCacheTimeStep;
+	// Keeps the shared frame in use alive while this player still refers to it
+	CreaturePackFrameCache::FramePtr cachedFrame;
+
+	int32 lastUvsIdx;
+	int32 lastColorsLowIdx, lastColorsHighIdx;
+	float lastColorsFraction;
+	// Last clips whose uvs/colors were sampled, static streams are skipped while these stay active
+	const CreaturePackAnimClip * lastUvsClip;
+	const CreaturePackAnimClip * lastColorsClip;
 };
\ No newline at end of file
@@ -0,0 +1,337 @@
+#pragma once
+
+#include "CreaturePackModule.hpp"
+#include <cmath>
+
+// Offline converter that re-encodes a Creature Pack file into the quantized pack format:
+// - Animation points are stored as int16 values quantized to the bounds of each clip
+// - Keyframes that can be rebuilt by interpolating their neighbours within errorTolerance are dropped
+// - Uvs and Colors are only written out on the samples where they change
+// The output is still read in by CreaturePackLoader directly.
+class CreaturePackQuantizer {
+public:
+	CreaturePackQuantizer(float errorToleranceIn = 0.0f)
+	{
+		errorTolerance = errorToleranceIn;
+	}
+
+	virtual ~CreaturePackQuantizer() {}
+
+	std::vector<uint8_t> convert(const std::vector<uint8_t>& byteArray) const
+	{
+		CreaturePackLoader srcData(byteArray);
+		if (srcData.isQuantized() || (srcData.getAnimationNum() == 0))
+		{
+			return byteArray;
+		}
+
+		// Gather the samples to keep for every clip
+		std::vector<std::vector<int32>> clipSamplesList;
+		int32 firstAnimOffset = (int32)srcData.fileData.size();
+		int32 lastAnimOffset = 0;
+		for (size_t i = 0; i < srcData.getAnimationNum(); i++)
+		{
+			const auto& curOffsetPair = srcData.getAnimationOffsets(i);
+			firstAnimOffset = std::min(firstAnimOffset, curOffsetPair.first);
+			lastAnimOffset = std::max(lastAnimOffset, curOffsetPair.second);
+
+			std::vector<int32> samplesList;
+			for (int32 k = curOffsetPair.first + 1; k < curOffsetPair.second; k += 4)
+			{
+				samplesList.push_back(k);
+			}
+
+			std::sort(samplesList.begin(), samplesList.end(), [&srcData](int32 a, int32 b)
+			{
+				return srcData.fileData[a].float_val < srcData.fileData[b].float_val;
+			});
+
+			clipSamplesList.push_back(reduceKeyframes(srcData, samplesList));
+		}
+
+		// Work out the new animation offsets: name + bounds + 4 objects per sample
+		std::vector<int32> newAnimPairsOffsetList;
+		int32 curOffset = firstAnimOffset;
+		for (auto& curSamples : clipSamplesList)
+		{
+			int32 clipSize = 2 + (int32)curSamples.size() * 4;
+			newAnimPairsOffsetList.push_back(curOffset);
+			newAnimPairsOffsetList.push_back(curOffset + clipSize);
+			curOffset += clipSize;
+		}
+
+		mpMini::msg_mini_writer writer;
+		int32 objectsNum = curOffset + ((int32)srcData.fileData.size() - lastAnimOffset);
+		writer.write_array_size((uint32_t)objectsNum);
+
+		std::vector<std::string> newHeaderList = srcData.headerList;
+		newHeaderList.push_back(CreaturePackLoader::getQuantizedTag());
+		writer.write_str_array(newHeaderList);
+		writer.write_int_array(newAnimPairsOffsetList);
+
+		// Base mesh data is written out as is
+		for (int32 k = srcData.getBaseIndicesOffset(); k < firstAnimOffset; k++)
+		{
+			writer.write_generic(srcData.fileData[k]);
+		}
+
+		for (size_t i = 0; i < clipSamplesList.size(); i++)
+		{
+			const auto& curOffsetPair = srcData.getAnimationOffsets(i);
+			writeClip(srcData, srcData.fileData[curOffsetPair.first].string_val, clipSamplesList[i], writer);
+		}
+
+		for (int32 k = lastAnimOffset; k < (int32)srcData.fileData.size(); k++)
+		{
+			writer.write_generic(srcData.fileData[k]);
+		}
+
+		return writer.get_data();
+	}
+
+	// Round trip check of a converted pack: decodes dstBytes and samples every keyframe of srcBytes from it.
+	// Fails if any point is further off than errorTolerance plus half a quantization step.
+	bool verify(const std::vector<uint8_t>& srcBytes, const std::vector<uint8_t>& dstBytes) const
+	{
+		CreaturePackLoader srcData(srcBytes);
+		CreaturePackLoader dstData(dstBytes);
+		if ((srcData.getAnimationNum() != dstData.getAnimationNum())
+			|| (srcData.getNumPoints() != dstData.getNumPoints()))
+		{
+			return false;
+		}
+
+		for (auto& srcPair : srcData.animClipMap)
+		{
+			auto dstIter = dstData.animClipMap.find(srcPair.first);
+			if (dstIter == dstData.animClipMap.end())
+			{
+				return false;
+			}
+
+			const CreaturePackAnimClip& srcClip = srcPair.second;
+			const CreaturePackAnimClip& dstClip = dstIter->second;
+			float maxError[2];
+			for (int32 i = 0; i < 2; i++)
+			{
+				maxError[i] = errorTolerance + (dstClip.quantized ? (0.5f * dstClip.quantScale[i]) : 0.0f) + 0.0001f;
+			}
+
+			for (auto& srcSample : srcClip.timeSamplesMap)
+			{
+				if (srcSample.second.dataIdx < 0)
+				{
+					continue;
+				}
+
+				const auto& srcPoints = getPoints(srcData, srcSample.second.dataIdx);
+				auto sampleData = dstClip.sampleTime((float)srcSample.first);
+				auto lowIter = dstClip.timeSamplesMap.find(sampleData.firstSampleIdx);
+				auto highIter = dstClip.timeSamplesMap.find(sampleData.secondSampleIdx);
+				if ((lowIter == dstClip.timeSamplesMap.end()) || (highIter == dstClip.timeSamplesMap.end())
+					|| (lowIter->second.dataIdx < 0) || (highIter->second.dataIdx < 0))
+				{
+					return false;
+				}
+
+				const auto& lowPoints = dstData.fileData[lowIter->second.dataIdx + 1];
+				const auto& highPoints = dstData.fileData[highIter->second.dataIdx + 1];
+				size_t dstPointsNum = dstClip.quantized ? lowPoints.short_array_val.size() : lowPoints.float_array_val.size();
+				size_t dstHighPointsNum = dstClip.quantized ? highPoints.short_array_val.size() : highPoints.float_array_val.size();
+				if ((dstPointsNum != srcPoints.size()) || (dstHighPointsNum != srcPoints.size()))
+				{
+					return false;
+				}
+
+				float fraction = sampleData.sampleFraction;
+				for (size_t j = 0; j < srcPoints.size(); j++)
+				{
+					float dstVal = ((1.0f - fraction) * dstClip.readPoint(lowPoints, j)) + (fraction * dstClip.readPoint(highPoints, j));
+					if (std::fabs(dstVal - srcPoints[j]) > maxError[j & 1])
+					{
+						return false;
+					}
+				}
+			}
+		}
+
+		return true;
+	}
+
+	// Max error in units of each point coordinate allowed when dropping keyframes. 0 keeps every keyframe.
+	float errorTolerance;
+
+protected:
+	const std::vector<float>& getPoints(const CreaturePackLoader& srcData, int32 sampleIdx) const
+	{
+		return srcData.fileData[sampleIdx + 1].float_array_val;
+	}
+
+	const std::vector<float>& getUvs(const CreaturePackLoader& srcData, int32 sampleIdx) const
+	{
+		return srcData.fileData[sampleIdx + 2].float_array_val;
+	}
+
+	const std::vector<int32_t>& getColors(const CreaturePackLoader& srcData, int32 sampleIdx) const
+	{
+		return srcData.fileData[sampleIdx + 3].int_array_val;
+	}
+
+	// Tests if every sample between startIdx and endIdx can be rebuilt by the runtime interpolating between those two
+	bool canDropRange(const CreaturePackLoader& srcData, const std::vector<int32>& samplesList, size_t startIdx, size_t endIdx) const
+	{
+		int32 startSample = samplesList[startIdx];
+		int32 endSample = samplesList[endIdx];
+		float startTime = (float)(int32)srcData.fileData[startSample].float_val;
+		float endTime = (float)(int32)srcData.fileData[endSample].float_val;
+		if ((endTime - startTime) <= 0.0001f)
+		{
+			return false;
+		}
+
+		const auto& startPoints = getPoints(srcData, startSample);
+		const auto& endPoints = getPoints(srcData, endSample);
+		const auto& startColors = getColors(srcData, startSample);
+		const auto& endColors = getColors(srcData, endSample);
+
+		for (size_t i = startIdx + 1; i < endIdx; i++)
+		{
+			int32 curSample = samplesList[i];
+			float curTime = (float)(int32)srcData.fileData[curSample].float_val;
+			float fraction = (curTime - startTime) / (endTime - startTime);
+
+			// Uvs are not interpolated, the runtime always takes them from the lower sample
+			if (getUvs(srcData, curSample) != getUvs(srcData, startSample))
+			{
+				return false;
+			}
+
+			const auto& curPoints = getPoints(srcData, curSample);
+			if ((curPoints.size() != startPoints.size()) || (curPoints.size() != endPoints.size()))
+			{
+				return false;
+			}
+
+			for (size_t j = 0; j < curPoints.size(); j++)
+			{
+				float interpVal = ((1.0f - fraction) * startPoints[j]) + (fraction * endPoints[j]);
+				if (std::fabs(interpVal - curPoints[j]) > errorTolerance)
+				{
+					return false;
+				}
+			}
+
+			const auto& curColors = getColors(srcData, curSample);
+			if ((curColors.size() != startColors.size()) || (curColors.size() != endColors.size()))
+			{
+				return false;
+			}
+
+			for (size_t j = 0; j < curColors.size(); j++)
+			{
+				float interpVal = ((1.0f - fraction) * (float)startColors[j]) + (fraction * (float)endColors[j]);
+				if (std::fabs(interpVal - (float)curColors[j]) > 1.0f)
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	std::vector<int32> reduceKeyframes(const CreaturePackLoader& srcData, const std::vector<int32>& samplesList) const
+	{
+		if ((errorTolerance <= 0.0f) || (samplesList.size() <= 2))
+		{
+			return samplesList;
+		}
+
+		std::vector<int32> keptList;
+		keptList.push_back(samplesList[0]);
+		size_t anchorIdx = 0;
+		for (size_t j = 1; j < samplesList.size(); j++)
+		{
+			bool isLast = ((j + 1) == samplesList.size());
+			if (!isLast && canDropRange(srcData, samplesList, anchorIdx, j + 1))
+			{
+				continue;
+			}
+
+			keptList.push_back(samplesList[j]);
+			anchorIdx = j;
+		}
+
+		return keptList;
+	}
+
+	void writeClip(
+		const CreaturePackLoader& srcData,
+		const std::string& animName,
+		const std::vector<int32>& samplesList,
+		mpMini::msg_mini_writer& writer) const
+	{
+		// Clip bounds: [min_x, min_y, max_x, max_y]
+		std::vector<float> bounds = { FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX };
+		for (auto curSample : samplesList)
+		{
+			const auto& curPoints = getPoints(srcData, curSample);
+			for (size_t j = 0; j < curPoints.size(); j++)
+			{
+				bounds[j & 1] = std::min(bounds[j & 1], curPoints[j]);
+				bounds[(j & 1) + 2] = std::max(bounds[(j & 1) + 2], curPoints[j]);
+			}
+		}
+
+		if (bounds[0] > bounds[2])
+		{
+			bounds = { 0, 0, 0, 0 };
+		}
+
+		writer.write_str(animName);
+		writer.write_float_array(bounds);
+
+		const std::vector<float> emptyUvs;
+		const std::vector<int32_t> emptyColors;
+		const std::vector<float> * lastUvs = nullptr;
+		const std::vector<int32_t> * lastColors = nullptr;
+		std::vector<int16_t> quantPoints;
+
+		for (auto curSample : samplesList)
+		{
+			writer.write_float(srcData.fileData[curSample].float_val);
+
+			const auto& curPoints = getPoints(srcData, curSample);
+			quantPoints.resize(curPoints.size());
+			for (size_t j = 0; j < curPoints.size(); j++)
+			{
+				float range = bounds[(j & 1) + 2] - bounds[j & 1];
+				float normVal = (range > 0.0f) ? ((curPoints[j] - bounds[j & 1]) / range) : 0.0f;
+				int32 quantVal = (int32)roundf(normVal * 65535.0f) - 32768;
+				quantPoints[j] = (int16_t)std::max(-32768, std::min(32767, quantVal));
+			}
+
+			writer.write_short_bin(quantPoints);
+
+			const auto& curUvs = getUvs(srcData, curSample);
+			if ((lastUvs == nullptr) || (*lastUvs != curUvs))
+			{
+				writer.write_float_array(curUvs);
+				lastUvs = &curUvs;
+			}
+			else {
+				writer.write_float_array(emptyUvs);
+			}
+
+			const auto& curColors = getColors(srcData, curSample);
+			if ((lastColors == nullptr) || (*lastColors != curColors))
+			{
+				writer.write_int_array(curColors);
+				lastColors = &curColors;
+			}
+			else {
+				writer.write_int_array(emptyColors);
+			}
+		}
+	}
+};
@@ -65,6 +65,8 @@ public:
 
 	void SetNeedsIndexUpdate(bool flag_in);
 
+	void SetNeedsAttributeUpdate(bool flag_in);
+
 	void UpdateMaterial();
 
 	void DoneUpdating();
@@ -94,6 +96,7 @@ private:
 	FMaterialRelevance MaterialRelevance;
 	bool needs_updating;
 	bool needs_index_updating;
+	bool needs_attribute_updating;
 	bool needs_material_updating;
 };
 
@@ -176,6 +179,9 @@ public:
 
 	void RecreateRenderProxy(bool flag_in);
 
+	// Flags the UV/Color vertex stream for re-upload on the next update
+	void MarkAttributesDirty();
+
 	bool SetProceduralMeshTriData(const FProceduralPackMeshTriData& TriData);
 
 
@@ -204,4 +210,5 @@ protected:
 	bool render_proxy_ready;
 	std::mutex local_lock;
 	bool recreate_render_proxy;
+	bool attributes_dirty;
 };
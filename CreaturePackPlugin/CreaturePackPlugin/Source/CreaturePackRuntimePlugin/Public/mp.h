@@ -7,7 +7,7 @@
 #include <sstream>
 #include <iostream>
 
-// BareBones MessagePack Reader, only handles ints, floats, arrays and strings
+// BareBones MessagePack Reader/Writer, only handles ints, floats, arrays, strings and int16 bin blobs
 
 namespace mpMini {
 	enum {
@@ -17,6 +17,8 @@ namespace mpMini {
 		MSG_MINI_GENERIC_ARRAY_INT_TYPE,
 		MSG_MINI_GENERIC_ARRAY_FLOAT_TYPE,
 		MSG_MINI_GENERIC_ARRAY_STRING_TYPE,
+		MSG_MINI_GENERIC_ARRAY_SHORT_TYPE,
+		MSG_MINI_GENERIC_ARRAY_EMPTY_TYPE,
 	};
 
 	class msg_mini_generic_data {
@@ -35,6 +37,7 @@ namespace mpMini {
 		std::vector<int32_t> int_array_val;
 		std::vector<float> float_array_val;
 		std::vector<std::string> str_array_val;
+		std::vector<int16_t> short_array_val;
 	};
 
 	union msg_mini_object_data {
@@ -52,6 +55,7 @@ namespace mpMini {
 		uint32_t  array_size;
 		uint32_t  map_size;
 		uint32_t  str_size;
+		uint32_t  bin_size;
 	};
 
 	class msg_mini_object {
@@ -144,6 +148,10 @@ namespace mpMini {
 
 		bool msg_mini_read_array(uint32_t *size);
 
+		bool msg_mini_read_bin_size(uint32_t *size);
+
+		bool msg_mini_read_short_bin(std::vector<int16_t>& data);
+
 		bool msg_mini_read_object(msg_mini_object *obj);
 
 		/* Data calls
@@ -187,6 +195,7 @@ namespace mpMini {
 		bool msg_mini_object_is_str(msg_mini_object *obj);
 		bool msg_mini_object_is_array(msg_mini_object *obj);
 		bool msg_mini_object_is_map(msg_mini_object *obj);
+		bool msg_mini_object_is_bin(msg_mini_object *obj);
 
 		bool msg_mini_object_as_char(msg_mini_object *obj, int8_t *c);
 		bool msg_mini_object_as_short(msg_mini_object *obj, int16_t *s);
@@ -204,6 +213,48 @@ namespace mpMini {
 
 	};
 
+	// Writes out data in the same main array layout that msg_mini reads back in
+	class msg_mini_writer {
+	protected:
+		std::vector<uint8_t> buf;
+
+		void write_bytes(const void *data, size_t size)
+		{
+			const uint8_t * base_ptr = (const uint8_t *)data;
+			buf.insert(buf.end(), base_ptr, base_ptr + size);
+		}
+
+	public:
+		msg_mini_writer() {}
+
+		virtual ~msg_mini_writer() {}
+
+		const std::vector<uint8_t>& get_data() const
+		{
+			return buf;
+		}
+
+		void write_array_size(uint32_t size);
+
+		void write_int(int32_t i);
+
+		void write_float(float f);
+
+		void write_str(const std::string& data);
+
+		// int16 values are packed little endian into a single bin blob
+		void write_short_bin(const std::vector<int16_t>& data);
+
+		void write_int_array(const std::vector<int32_t>& data);
+
+		void write_float_array(const std::vector<float>& data);
+
+		void write_str_array(const std::vector<std::string>& data);
+
+		// Writes back a generic object read in by msg_mini
+		void write_generic(const msg_mini_generic_data& data);
+	};
+
 
 
 }
\ No newline at end of file